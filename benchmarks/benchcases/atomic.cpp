@@ -0,0 +1,61 @@
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128_atomic.h"
+
+namespace {
+
+// every thread hammers the same counter
+atomic_uint128 shared_counter;
+std::atomic<std::uint64_t> shared_counter64;
+
+std::mutex shared_mutex;
+uint128_t shared_locked_counter;
+
+}
+
+static void BM_atomic_uint128_fetch_add(benchmark::State & state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shared_counter.fetch_add(1));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_atomic_uint128_fetch_add)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_atomic_uint128_compare_exchange(benchmark::State & state) {
+    for (auto _ : state) {
+        uint128_t expected = shared_counter.load();
+        while (!shared_counter.compare_exchange_weak(expected, expected * 3 + 1)) {
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_atomic_uint128_compare_exchange)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_atomic_uint128_load(benchmark::State & state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shared_counter.load());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_atomic_uint128_load)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_mutex_uint128_fetch_add(benchmark::State & state) {
+    for (auto _ : state) {
+        std::lock_guard const lock{ shared_mutex };
+        benchmark::DoNotOptimize(shared_locked_counter++);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_mutex_uint128_fetch_add)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_atomic_uint64_fetch_add(benchmark::State & state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shared_counter64.fetch_add(1));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_atomic_uint64_fetch_add)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,177 @@
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128_batch.h"
+
+namespace {
+
+constexpr std::size_t row_count = 100000;
+
+auto make_column(int const base) -> std::string {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::string text;
+    for (std::size_t i = 0; i < row_count; ++i) {
+        text += (uint128_t{ engine(), engine() } >> (engine() & 127)).str(static_cast<uint8_t>(base));
+        text += '\n';
+    }
+    return text;
+}
+
+}
+
+// One constructor call per row, rows split with memchr
+// Arg: base
+static void BM_parse_column_constructor(benchmark::State & state) {
+    auto const base = static_cast<uint8_t>(state.range(0));
+    std::string const text = make_column(base);
+    std::vector<uint128_t> values(row_count);
+
+    for (auto _ : state) {
+        char const * p = text.data();
+        char const * const end = text.data() + text.size();
+        std::size_t row = 0;
+        while (p != end) {
+            auto const * const newline = static_cast<char const *>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+            values[row++] = uint128_t(p, static_cast<std::size_t>(newline - p), base);
+            p = newline + 1;
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * row_count));
+}
+BENCHMARK(BM_parse_column_constructor)->Arg(10)->Arg(16);
+
+// Arg: base
+static void BM_parse_column(benchmark::State & state) {
+    auto const base = static_cast<int>(state.range(0));
+    std::string const text = make_column(base);
+    std::vector<uint128_t> values(row_count);
+    std::vector<uint64_t> errors((row_count + 63) / 64);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parse_column(text, '\n', std::span{ values }, std::span{ errors }, base));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * row_count));
+}
+BENCHMARK(BM_parse_column)->Arg(10)->Arg(16);
+
+// One str(16) call per row, appended to a string
+static void BM_format_hex_column_str(benchmark::State & state) {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::vector<uint128_t> values(row_count);
+    for (auto & value : values) {
+        value = uint128_t{ engine(), engine() };
+    }
+
+    std::string text;
+    text.reserve(row_count * 33);
+    for (auto _ : state) {
+        text.clear();
+        for (auto const & value : values) {
+            text += value.str(16, 32);
+            text += '\n';
+        }
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * row_count * 33));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * row_count));
+}
+BENCHMARK(BM_format_hex_column_str);
+
+static void BM_format_hex_column(benchmark::State & state) {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::vector<uint128_t> values(row_count);
+    for (auto & value : values) {
+        value = uint128_t{ engine(), engine() };
+    }
+
+    std::string text(row_count * 33, '\0');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(format_hex_column(values, text));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * row_count * 33));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * row_count));
+}
+BENCHMARK(BM_format_hex_column);
+
+namespace {
+
+auto make_matrix() -> std::vector<uint128_t> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::vector<uint128_t> matrix(128);
+    for (auto & row : matrix) {
+        row = uint128_t{ engine(), engine() };
+    }
+    return matrix;
+}
+
+void run_transpose(benchmark::State & state, uint128::details::transpose128_kernel const kernel) {
+    auto const in = make_matrix();
+    std::vector<uint128_t> out(128);
+    for (auto _ : state) {
+        kernel(in.data(), out.data());
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+}
+
+// one bit at a time with uint128_t shifts and masks
+static void BM_transpose_bitwise(benchmark::State & state) {
+    auto const in = make_matrix();
+    std::vector<uint128_t> out(128);
+    for (auto _ : state) {
+        for (unsigned j = 0; j < 128; ++j) {
+            uint128_t row = 0;
+            for (unsigned i = 0; i < 128; ++i) {
+                row |= ((in[i] >> j) & 1) << i;
+            }
+            out[j] = row;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_transpose_bitwise);
+
+static void BM_transpose_scalar(benchmark::State & state) {
+    run_transpose(state, uint128::details::transpose128_scalar);
+}
+BENCHMARK(BM_transpose_scalar);
+
+#if defined(__SSE2__) || defined(_M_X64)
+static void BM_transpose_sse2(benchmark::State & state) {
+    run_transpose(state, uint128::details::transpose128_sse2);
+}
+BENCHMARK(BM_transpose_sse2);
+#endif
+
+#if defined(UINT128_BATCH_X86_DISPATCH)
+static void BM_transpose_avx2(benchmark::State & state) {
+    if (!__builtin_cpu_supports("avx2")) {
+        state.SkipWithError("no AVX2");
+        return;
+    }
+    run_transpose(state, uint128::details::transpose128_avx2);
+}
+BENCHMARK(BM_transpose_avx2);
+
+static void BM_transpose_gfni(benchmark::State & state) {
+    if (!__builtin_cpu_supports("avx512vbmi") || !__builtin_cpu_supports("avx512bw") || !__builtin_cpu_supports("gfni")) {
+        state.SkipWithError("no AVX-512 VBMI and GFNI");
+        return;
+    }
+    run_transpose(state, uint128::details::transpose128_gfni);
+}
+BENCHMARK(BM_transpose_gfni);
+#endif
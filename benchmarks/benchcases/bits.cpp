@@ -0,0 +1,102 @@
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128_bit.h"
+
+namespace {
+
+constexpr std::size_t operand_count = 1024;
+
+struct select_operand {
+    uint128_t value;
+    uint32_t k;
+};
+
+// random values with k picked among their set bits
+auto make_operands() -> std::array<select_operand, operand_count> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::array<select_operand, operand_count> operands;
+    for (auto & [value, k] : operands) {
+        value = uint128_t{ engine(), engine() };
+        k = static_cast<uint32_t>(engine() % static_cast<uint64_t>(popcount(value)));
+    }
+    return operands;
+}
+
+}
+
+static void BM_popcount(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (auto const & [value, k] : operands) {
+            benchmark::DoNotOptimize(popcount(value));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_popcount);
+
+static void BM_countl_zero(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (auto const & [value, k] : operands) {
+            benchmark::DoNotOptimize(countl_zero(value >> k));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_countl_zero);
+
+static void BM_bit_reverse(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (auto const & [value, k] : operands) {
+            benchmark::DoNotOptimize(bit_reverse(value));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_bit_reverse);
+
+static void BM_rank(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (auto const & [value, k] : operands) {
+            benchmark::DoNotOptimize(rank(value, k));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_rank);
+
+static void BM_select(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (auto const & [value, k] : operands) {
+            benchmark::DoNotOptimize(select(value, k));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_select);
+
+// the same select by clearing the lowest set bit k times
+static void BM_select_by_clearing(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (auto const & [value, k] : operands) {
+            uint128_t bits = value;
+            for (uint32_t i = 0; i < k; ++i) {
+                bits &= bits - 1;
+            }
+            benchmark::DoNotOptimize(countr_zero(bits));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_select_by_clearing);
@@ -0,0 +1,163 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128_batch.h"
+
+namespace {
+
+constexpr std::size_t value_count = 1024;
+
+auto make_values() -> std::vector<uint128_t> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::vector<uint128_t> values(value_count);
+    for (auto & value : values) {
+        value = uint128_t{ engine(), engine() } >> (engine() & 127);
+    }
+    return values;
+}
+
+}
+
+static void BM_export_bits_vector(benchmark::State & state) {
+    auto const values = make_values();
+    for (auto _ : state) {
+        for (auto const & value : values) {
+            benchmark::DoNotOptimize(value.export_bits());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_export_bits_vector);
+
+static void BM_export_bits_compact_vector(benchmark::State & state) {
+    auto const values = make_values();
+    for (auto _ : state) {
+        for (auto const & value : values) {
+            benchmark::DoNotOptimize(value.export_bits_compact());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_export_bits_compact_vector);
+
+static void BM_to_bytes(benchmark::State & state) {
+    auto const values = make_values();
+    std::vector<std::array<std::byte, 16>> out(value_count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < value_count; ++i) {
+            out[i] = values[i].to_bytes();
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_to_bytes);
+
+static void BM_from_bytes(benchmark::State & state) {
+    auto const values = make_values();
+    std::vector<std::array<std::byte, 16>> bytes(value_count);
+    for (std::size_t i = 0; i < value_count; ++i) {
+        bytes[i] = values[i].to_bytes();
+    }
+    std::vector<uint128_t> out(value_count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < value_count; ++i) {
+            out[i] = uint128_t::from_bytes(bytes[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_from_bytes);
+
+static void BM_to_bytes_compact(benchmark::State & state) {
+    auto const values = make_values();
+    std::vector<std::byte> out(value_count * 16);
+    for (auto _ : state) {
+        std::size_t offset = 0;
+        for (auto const & value : values) {
+            offset += value.to_bytes_compact(std::span{ out }.subspan(offset));
+        }
+        benchmark::DoNotOptimize(offset);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_to_bytes_compact);
+
+// Bulk network order conversion, against one to_bytes / export_bits per value
+// Arg: number of values (1024 stays in L1, 1M is 16 MiB)
+namespace {
+
+auto make_bulk_values(std::size_t const bulk_count) -> std::vector<uint128_t> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::vector<uint128_t> values(bulk_count);
+    for (auto & value : values) {
+        value = uint128_t{ engine(), engine() };
+    }
+    return values;
+}
+
+}
+
+static void BM_hton_export_bits(benchmark::State & state) {
+    auto const bulk_count = static_cast<std::size_t>(state.range(0));
+    auto const values = make_bulk_values(bulk_count);
+    std::vector<uint8_t> wire(16 * bulk_count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < bulk_count; ++i) {
+            values[i].export_bits(std::span{ wire }.subspan(16 * i, 16));
+        }
+        benchmark::DoNotOptimize(wire.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * 16 * bulk_count));
+}
+BENCHMARK(BM_hton_export_bits)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_hton_to_bytes(benchmark::State & state) {
+    auto const bulk_count = static_cast<std::size_t>(state.range(0));
+    auto const values = make_bulk_values(bulk_count);
+    std::vector<std::array<std::byte, 16>> wire(bulk_count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < bulk_count; ++i) {
+            wire[i] = values[i].to_bytes();
+        }
+        benchmark::DoNotOptimize(wire.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * 16 * bulk_count));
+}
+BENCHMARK(BM_hton_to_bytes)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_hton(benchmark::State & state) {
+    auto const bulk_count = static_cast<std::size_t>(state.range(0));
+    auto const values = make_bulk_values(bulk_count);
+    std::vector<std::byte> wire(16 * bulk_count);
+    for (auto _ : state) {
+        hton(values, wire);
+        benchmark::DoNotOptimize(wire.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * 16 * bulk_count));
+}
+BENCHMARK(BM_hton)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_hton_in_place(benchmark::State & state) {
+    auto const bulk_count = static_cast<std::size_t>(state.range(0));
+    auto values = make_bulk_values(bulk_count);
+    for (auto _ : state) {
+        hton(values);
+        benchmark::DoNotOptimize(values.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * 16 * bulk_count));
+}
+BENCHMARK(BM_hton_in_place)->Arg(1 << 10)->Arg(1 << 20);
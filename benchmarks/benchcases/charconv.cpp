@@ -0,0 +1,115 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128.h"
+
+namespace {
+
+constexpr std::size_t value_count = 1024;
+
+// full_width: every value has the maximum number of digits, otherwise widths are random
+auto make_values(bool const full_width = false) -> std::array<uint128_t, value_count> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::array<uint128_t, value_count> values;
+    for (auto & value : values) {
+        value = uint128_t{ engine() | (full_width ? 0xf000000000000000ULL : 0), engine() } >> (full_width ? 0 : engine() & 127);
+    }
+    return values;
+}
+
+}
+
+// Arg: base
+static void BM_to_chars(benchmark::State & state) {
+    auto const values = make_values();
+    auto const base = static_cast<int>(state.range(0));
+    char buffer[128];
+    for (auto _ : state) {
+        for (auto const & value : values) {
+            benchmark::DoNotOptimize(to_chars(std::begin(buffer), std::end(buffer), value, base));
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_to_chars)->Arg(10)->Arg(16)->Arg(8)->Arg(2);
+
+// Args: base, full width
+static void BM_from_chars(benchmark::State & state) {
+    auto const values = make_values(state.range(1) != 0);
+    auto const base = static_cast<int>(state.range(0));
+
+    std::array<std::array<char, 128>, value_count> texts{};
+    std::array<std::size_t, value_count> sizes{};
+    for (std::size_t i = 0; i < value_count; ++i) {
+        sizes[i] = static_cast<std::size_t>(to_chars(texts[i].data(), texts[i].data() + texts[i].size(), values[i], base).ptr - texts[i].data());
+    }
+
+    std::size_t bytes = 0;
+    for (auto const size : sizes) {
+        bytes += size;
+    }
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < value_count; ++i) {
+            uint128_t value;
+            benchmark::DoNotOptimize(from_chars(texts[i].data(), texts[i].data() + sizes[i], value, base));
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_from_chars)->Args({ 10, 0 })->Args({ 16, 0 })->Args({ 10, 1 })->Args({ 16, 1 });
+
+// Fixed-width 32 digit hexadecimal output
+static void BM_to_hex_chars(benchmark::State & state) {
+    auto const values = make_values();
+    char buffer[32];
+    for (auto _ : state) {
+        for (auto const & value : values) {
+            benchmark::DoNotOptimize(to_hex_chars(std::begin(buffer), std::end(buffer), value));
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_to_hex_chars);
+
+static void BM_ostream(benchmark::State & state) {
+    auto const values = make_values();
+    std::ostringstream stream;
+    for (auto _ : state) {
+        stream.seekp(0);
+        for (auto const & value : values) {
+            stream << value << '\n';
+        }
+        benchmark::DoNotOptimize(stream);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_ostream);
+
+static void BM_istream(benchmark::State & state) {
+    auto const values = make_values();
+    std::ostringstream text;
+    for (auto const & value : values) {
+        text << value.str() << '\n';
+    }
+    std::istringstream stream(text.str());
+    for (auto _ : state) {
+        stream.clear();
+        stream.seekg(0);
+        uint128_t value;
+        while (stream >> value) {
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_istream);
@@ -0,0 +1,143 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128_codec.h"
+
+namespace {
+
+constexpr std::size_t value_count = 4096;
+
+// small: counters below 2^20, otherwise random bit widths
+auto make_values(bool const small) -> std::vector<uint128_t> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::vector<uint128_t> values(value_count);
+    for (auto & value : values) {
+        value = small ? uint128_t{ engine() % (1 << 20) } : uint128_t{ engine(), engine() } >> (engine() & 127);
+    }
+    return values;
+}
+
+// one group of 7 bits per iteration
+auto encode_leb128_bytewise(uint128_t value, std::byte * p) -> std::byte * {
+    while (value >= 0x80) {
+        *p++ = static_cast<std::byte>(value.lower() | 0x80);
+        value >>= 7;
+    }
+    *p++ = static_cast<std::byte>(value.lower());
+    return p;
+}
+
+auto decode_leb128_bytewise(std::byte const * p, uint128_t & value) -> std::byte const * {
+    value = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        auto const byte = std::to_integer<uint64_t>(*p++);
+        value |= uint128_t{ byte & 0x7f } << shift;
+        if (!(byte & 0x80)) {
+            return p;
+        }
+    }
+}
+
+}
+
+// Arg: small values
+static void BM_export_bits_compact_per_value(benchmark::State & state) {
+    auto const values = make_values(state.range(0) != 0);
+    std::vector<uint8_t> out;
+    out.reserve(value_count * 17);
+    for (auto _ : state) {
+        out.clear();
+        for (auto const & value : values) {
+            auto const bytes = value.export_bits_compact();
+            out.push_back(static_cast<uint8_t>(bytes.size()));
+            out.insert(out.end(), bytes.begin(), bytes.end());
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_export_bits_compact_per_value)->Arg(1)->Arg(0);
+
+static void BM_encode_leb128_bytewise(benchmark::State & state) {
+    auto const values = make_values(state.range(0) != 0);
+    std::vector<std::byte> out(value_count * leb128_max_size);
+    for (auto _ : state) {
+        std::byte * p = out.data();
+        for (auto const & value : values) {
+            p = encode_leb128_bytewise(value, p);
+        }
+        benchmark::DoNotOptimize(p);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_encode_leb128_bytewise)->Arg(1)->Arg(0);
+
+static void BM_encode_leb128(benchmark::State & state) {
+    auto const values = make_values(state.range(0) != 0);
+    std::vector<std::byte> out(value_count * leb128_max_size);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encode_leb128(values, out));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_encode_leb128)->Arg(1)->Arg(0);
+
+static void BM_encode_compact(benchmark::State & state) {
+    auto const values = make_values(state.range(0) != 0);
+    std::vector<std::byte> out(value_count * compact_max_size);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encode_compact(values, out));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_encode_compact)->Arg(1)->Arg(0);
+
+static void BM_decode_leb128_bytewise(benchmark::State & state) {
+    auto const values = make_values(state.range(0) != 0);
+    std::vector<std::byte> wire(value_count * leb128_max_size);
+    encode_leb128(values, wire);
+    std::vector<uint128_t> out(value_count);
+    for (auto _ : state) {
+        std::byte const * p = wire.data();
+        for (auto & value : out) {
+            p = decode_leb128_bytewise(p, value);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_decode_leb128_bytewise)->Arg(1)->Arg(0);
+
+static void BM_decode_leb128(benchmark::State & state) {
+    auto const values = make_values(state.range(0) != 0);
+    std::vector<std::byte> wire(value_count * leb128_max_size);
+    auto const end = encode_leb128(values, wire).ptr;
+    std::vector<uint128_t> out(value_count);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(decode_leb128(std::span<std::byte const>(wire.data(), end), out));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_decode_leb128)->Arg(1)->Arg(0);
+
+static void BM_decode_compact(benchmark::State & state) {
+    auto const values = make_values(state.range(0) != 0);
+    std::vector<std::byte> wire(value_count * compact_max_size);
+    auto const end = encode_compact(values, wire).ptr;
+    std::vector<uint128_t> out(value_count);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(decode_compact(std::span<std::byte const>(wire.data(), end), out));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * value_count));
+}
+BENCHMARK(BM_decode_compact)->Arg(1)->Arg(0);
@@ -0,0 +1,48 @@
+#include <atomic>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128_atomic.h"
+#include "uint128_counter.h"
+
+namespace {
+
+// one slot per benchmark thread at the largest thread count
+striped_uint128_counter striped_counter{ 64 };
+atomic_uint128 shared_counter;
+std::atomic<std::uint64_t> shared_counter64;
+
+}
+
+static void BM_striped_counter_add(benchmark::State & state) {
+    for (auto _ : state) {
+        striped_counter.add(1500);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_striped_counter_add)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_striped_counter_read(benchmark::State & state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(striped_counter.read());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_striped_counter_read);
+
+static void BM_shared_atomic_uint128_add(benchmark::State & state) {
+    for (auto _ : state) {
+        static_cast<void>(shared_counter += 1500);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_shared_atomic_uint128_add)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_shared_atomic_uint64_add(benchmark::State & state) {
+    for (auto _ : state) {
+        shared_counter64.fetch_add(1500, std::memory_order_relaxed);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_shared_atomic_uint64_add)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,85 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128.h"
+
+namespace {
+
+constexpr std::size_t operand_count = 1024;
+
+auto make_operands(int const divisor_bits) -> std::array<std::pair<uint128_t, uint128_t>, operand_count> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::array<std::pair<uint128_t, uint128_t>, operand_count> operands;
+    for (auto & [lhs, rhs] : operands) {
+        lhs = uint128_t{ engine(), engine() };
+        rhs = uint128_t{ engine(), engine() } >> (128 - divisor_bits);
+        if (!rhs) {
+            rhs = 1;
+        }
+    }
+    return operands;
+}
+
+}
+
+static void BM_divide_operator(benchmark::State & state) {
+    auto const operands = make_operands(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        for (auto const & [lhs, rhs] : operands) {
+            benchmark::DoNotOptimize(lhs / rhs);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_divide_operator)->Arg(32)->Arg(64)->Arg(96)->Arg(128);
+
+static void BM_str_decimal(benchmark::State & state) {
+    auto const operands = make_operands(128);
+    for (auto _ : state) {
+        for (auto const & operand : operands) {
+            benchmark::DoNotOptimize(operand.first.str());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_str_decimal);
+
+// scalar divisor widened to uint128_t first, the previous operator/(std::integral auto)
+static void BM_divide_by_u64_widened(benchmark::State & state) {
+    auto const operands = make_operands(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        for (auto const & [lhs, rhs] : operands) {
+            benchmark::DoNotOptimize(lhs / uint128_t{ rhs.lower() });
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_divide_by_u64_widened)->Arg(8)->Arg(32)->Arg(64);
+
+static void BM_divide_by_u64(benchmark::State & state) {
+    auto const operands = make_operands(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        for (auto const & [lhs, rhs] : operands) {
+            benchmark::DoNotOptimize(lhs / rhs.lower());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_divide_by_u64)->Arg(8)->Arg(32)->Arg(64);
+
+// dividend below 2^64 * divisor: a single hardware divide
+static void BM_divide_by_u64_one_step(benchmark::State & state) {
+    auto const operands = make_operands(64);
+    for (auto _ : state) {
+        for (auto const & [lhs, rhs] : operands) {
+            uint64_t const divisor = rhs.lower() | 0x8000000000000000ULL;
+            benchmark::DoNotOptimize((lhs >> 1) / divisor);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_divide_by_u64_one_step);
@@ -0,0 +1,63 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128_divider.h"
+
+namespace {
+
+constexpr std::size_t numerator_count = 4096;
+
+auto make_numerators() -> std::vector<uint128_t> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::vector<uint128_t> numerators(numerator_count);
+    for (auto & numerator : numerators) {
+        numerator = uint128_t{ engine(), engine() };
+    }
+    return numerators;
+}
+
+// Arg: bit width of the divisor
+auto make_divisor(int64_t const bits) -> uint128_t {
+    return uint128_t{ 0x9e3779b97f4a7c15ULL, 0xf39cc0605cedc835ULL } >> (128 - bits);
+}
+
+}
+
+static void BM_divide_by_invariant_operator(benchmark::State & state) {
+    auto const numerators = make_numerators();
+    uint128_t const divisor = make_divisor(state.range(0));
+    for (auto _ : state) {
+        for (auto const & numerator : numerators) {
+            benchmark::DoNotOptimize(numerator / divisor);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numerator_count));
+}
+BENCHMARK(BM_divide_by_invariant_operator)->Arg(20)->Arg(64)->Arg(100)->Arg(128);
+
+static void BM_divide_by_invariant_divider(benchmark::State & state) {
+    auto const numerators = make_numerators();
+    uint128_divider const divider{ make_divisor(state.range(0)) };
+    for (auto _ : state) {
+        for (auto const & numerator : numerators) {
+            benchmark::DoNotOptimize(numerator / divider);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numerator_count));
+}
+BENCHMARK(BM_divide_by_invariant_divider)->Arg(20)->Arg(64)->Arg(100)->Arg(128);
+
+static void BM_divide_by_invariant_branchfree_divider(benchmark::State & state) {
+    auto const numerators = make_numerators();
+    uint128_branchfree_divider const divider{ make_divisor(state.range(0)) };
+    for (auto _ : state) {
+        for (auto const & numerator : numerators) {
+            benchmark::DoNotOptimize(numerator / divider);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numerator_count));
+}
+BENCHMARK(BM_divide_by_invariant_branchfree_divider)->Arg(20)->Arg(64)->Arg(100)->Arg(128);
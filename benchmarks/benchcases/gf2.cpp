@@ -0,0 +1,110 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128_gf2.h"
+
+namespace {
+
+constexpr std::size_t block_count = 1024;
+
+auto make_blocks() -> std::vector<uint128_t> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::vector<uint128_t> blocks(block_count);
+    for (auto & block : blocks) {
+        block = uint128_t{ engine(), engine() };
+    }
+    return blocks;
+}
+
+// shift and xor, one bit of b at a time, on uint128_t operators
+auto clmul_shift_xor(uint64_t const a, uint64_t const b) -> uint128_t {
+    uint128_t product = 0;
+    for (unsigned i = 0; i < 64; ++i) {
+        product ^= (uint128_t(a) << i) & uint128_t(0 - ((b >> i) & 1), 0 - ((b >> i) & 1));
+    }
+    return product;
+}
+
+void run_absorb(benchmark::State & state, uint128::details::gf2_128_absorb_kernel const kernel) {
+    auto const blocks = make_blocks();
+    gf2_128 const h{ blocks[0] };
+    std::vector<uint128_t> powers(8);
+    for (std::size_t i = 0; i < powers.size(); ++i) {
+        powers[i] = h.pow(8 - i).bits();
+    }
+
+    uint128_t acc = 0;
+    for (auto _ : state) {
+        acc = kernel(powers.data(), acc, blocks.data(), blocks.size());
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * block_count * 16));
+}
+
+}
+
+static void BM_clmul_shift_xor(benchmark::State & state) {
+    auto const blocks = make_blocks();
+    for (auto _ : state) {
+        for (auto const & block : blocks) {
+            benchmark::DoNotOptimize(clmul_shift_xor(block.upper(), block.lower()));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * block_count));
+}
+BENCHMARK(BM_clmul_shift_xor);
+
+static void BM_clmul(benchmark::State & state) {
+    auto const blocks = make_blocks();
+    for (auto _ : state) {
+        for (auto const & block : blocks) {
+            benchmark::DoNotOptimize(clmul(block.upper(), block.lower()));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * block_count));
+}
+BENCHMARK(BM_clmul);
+
+// one multiply and one reduction per block
+static void BM_gf2_128_horner(benchmark::State & state) {
+    auto const blocks = make_blocks();
+    gf2_128 const h{ blocks[0] };
+    gf2_128 acc;
+    for (auto _ : state) {
+        for (auto const & block : blocks) {
+            acc = (acc + gf2_128{ block }) * h;
+        }
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * block_count * 16));
+}
+BENCHMARK(BM_gf2_128_horner);
+
+static void BM_gf2_128_absorb_portable(benchmark::State & state) {
+    run_absorb(state, uint128::details::gf2_128_absorb_portable);
+}
+BENCHMARK(BM_gf2_128_absorb_portable);
+
+#if defined(UINT128_GF2_X86_DISPATCH)
+static void BM_gf2_128_absorb_pclmul(benchmark::State & state) {
+    if (!__builtin_cpu_supports("pclmul")) {
+        state.SkipWithError("no PCLMULQDQ");
+        return;
+    }
+    run_absorb(state, uint128::details::gf2_128_absorb_pclmul);
+}
+BENCHMARK(BM_gf2_128_absorb_pclmul);
+
+static void BM_gf2_128_absorb_vpclmul(benchmark::State & state) {
+    if (!__builtin_cpu_supports("vpclmulqdq") || !__builtin_cpu_supports("avx512f")) {
+        state.SkipWithError("no VPCLMULQDQ");
+        return;
+    }
+    run_absorb(state, uint128::details::gf2_128_absorb_vpclmul);
+}
+BENCHMARK(BM_gf2_128_absorb_vpclmul);
+#endif
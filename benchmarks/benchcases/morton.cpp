@@ -0,0 +1,107 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128_morton.h"
+
+namespace {
+
+constexpr std::size_t operand_count = 1024;
+
+auto make_coordinates() -> std::vector<uint64_t> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::vector<uint64_t> coordinates(operand_count);
+    for (auto & c : coordinates) {
+        c = engine();
+    }
+    return coordinates;
+}
+
+}
+
+// one bit at a time on top of uint128_t shifts and ors
+static void BM_morton_encode_bitwise(benchmark::State & state) {
+    auto const xs = make_coordinates();
+    auto const ys = make_coordinates();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < operand_count; ++i) {
+            uint128_t key = 0;
+            for (unsigned b = 0; b < 64; ++b) {
+                key |= uint128_t((xs[i] >> b) & 1) << (2 * b);
+                key |= uint128_t((ys[i] >> b) & 1) << (2 * b + 1);
+            }
+            benchmark::DoNotOptimize(key);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_morton_encode_bitwise);
+
+static void BM_morton_encode(benchmark::State & state) {
+    auto const xs = make_coordinates();
+    auto const ys = make_coordinates();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < operand_count; ++i) {
+            benchmark::DoNotOptimize(morton_encode(xs[i], ys[i]));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_morton_encode);
+
+static void BM_morton_encode_span(benchmark::State & state) {
+    auto const xs = make_coordinates();
+    auto const ys = make_coordinates();
+    std::vector<uint128_t> keys(operand_count);
+    for (auto _ : state) {
+        morton_encode(xs, ys, keys);
+        benchmark::DoNotOptimize(keys.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_morton_encode_span);
+
+static void BM_morton_decode_span(benchmark::State & state) {
+    auto const xs = make_coordinates();
+    auto const ys = make_coordinates();
+    std::vector<uint128_t> keys(operand_count);
+    morton_encode(xs, ys, keys);
+    std::vector<uint64_t> out_xs(operand_count);
+    std::vector<uint64_t> out_ys(operand_count);
+    for (auto _ : state) {
+        morton_decode(keys, out_xs, out_ys);
+        benchmark::DoNotOptimize(out_xs.data());
+        benchmark::DoNotOptimize(out_ys.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_morton_decode_span);
+
+static void BM_hilbert_encode(benchmark::State & state) {
+    auto const xs = make_coordinates();
+    auto const ys = make_coordinates();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < operand_count; ++i) {
+            benchmark::DoNotOptimize(hilbert_encode(xs[i], ys[i]));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_hilbert_encode);
+
+static void BM_pdep(benchmark::State & state) {
+    auto const values = make_coordinates();
+    auto const masks = make_coordinates();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; i += 2) {
+            benchmark::DoNotOptimize(pdep(uint128_t(values[i], values[i + 1]), uint128_t(masks[i], masks[i + 1])));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count / 2));
+}
+BENCHMARK(BM_pdep);
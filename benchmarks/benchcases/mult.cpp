@@ -0,0 +1,121 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128.h"
+
+namespace {
+
+constexpr std::size_t operand_count = 1024;
+
+auto make_operands() -> std::array<uint128_t, operand_count> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::array<uint128_t, operand_count> operands;
+    for (auto & operand : operands) {
+        operand = uint128_t{ engine(), engine() };
+    }
+    return operands;
+}
+
+}
+
+// 16 32x32->64 partial products, the previous operator* implementation
+static void BM_multiply_limbs(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; ++i) {
+            uint64_t upper{};
+            uint64_t const lower = uint128::details::mul128_limbs(operands[i].upper(), operands[i].lower(), operands[i + 1].upper(), operands[i + 1].lower(), upper);
+            benchmark::DoNotOptimize(upper);
+            benchmark::DoNotOptimize(lower);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 1)));
+}
+BENCHMARK(BM_multiply_limbs);
+
+static void BM_multiply_operator(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; ++i) {
+            benchmark::DoNotOptimize(operands[i] * operands[i + 1]);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 1)));
+}
+BENCHMARK(BM_multiply_operator);
+
+static void BM_mul_wide(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; ++i) {
+            benchmark::DoNotOptimize(mul_wide(operands[i], operands[i + 1]));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 1)));
+}
+BENCHMARK(BM_mul_wide);
+
+static void BM_mulhi(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; ++i) {
+            benchmark::DoNotOptimize(mulhi(operands[i], operands[i + 1]));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 1)));
+}
+BENCHMARK(BM_mulhi);
+
+// multiply, then a 256-bit add of the addend
+static void BM_mul_wide_then_add(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 2 < operand_count; ++i) {
+            auto [hi, lo] = mul_wide(operands[i], operands[i + 1]);
+            lo += operands[i + 2];
+            hi += lo < operands[i + 2];
+            benchmark::DoNotOptimize(hi);
+            benchmark::DoNotOptimize(lo);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 2)));
+}
+BENCHMARK(BM_mul_wide_then_add);
+
+static void BM_mul_add_wide(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 2 < operand_count; ++i) {
+            benchmark::DoNotOptimize(mul_add_wide(operands[i], operands[i + 1], operands[i + 2]));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 2)));
+}
+BENCHMARK(BM_mul_add_wide);
+
+// scalar factor widened to uint128_t first, the previous operator*(std::integral auto)
+static void BM_multiply_by_u64_widened(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; ++i) {
+            benchmark::DoNotOptimize(operands[i] * uint128_t{ operands[i + 1].lower() });
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 1)));
+}
+BENCHMARK(BM_multiply_by_u64_widened);
+
+static void BM_multiply_by_u64(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; ++i) {
+            benchmark::DoNotOptimize(operands[i] * operands[i + 1].lower());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 1)));
+}
+BENCHMARK(BM_multiply_by_u64);
@@ -0,0 +1,90 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128.h"
+
+namespace {
+
+constexpr std::size_t operand_count = 1024;
+
+// random bit widths, so that about half of the products overflow
+auto make_operands() -> std::array<uint128_t, operand_count> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::array<uint128_t, operand_count> operands;
+    for (auto & operand : operands) {
+        operand = uint128_t{ engine(), engine() } >> (engine() & 127);
+    }
+    return operands;
+}
+
+}
+
+// the guard the checked functions replace: a comparison for add, a division for mul
+static void BM_add_checked_by_compare(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; ++i) {
+            uint128_t const sum = operands[i] + operands[i + 1];
+            benchmark::DoNotOptimize(sum);
+            benchmark::DoNotOptimize(sum < operands[i]);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 1)));
+}
+BENCHMARK(BM_add_checked_by_compare);
+
+static void BM_add_overflow(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; ++i) {
+            uint128_t sum;
+            bool const overflow = add_overflow(operands[i], operands[i + 1], sum);
+            benchmark::DoNotOptimize(sum);
+            benchmark::DoNotOptimize(overflow);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 1)));
+}
+BENCHMARK(BM_add_overflow);
+
+static void BM_mul_checked_by_division(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; ++i) {
+            uint128_t const product = operands[i] * operands[i + 1];
+            benchmark::DoNotOptimize(product);
+            benchmark::DoNotOptimize(operands[i] != 0 && product / operands[i] != operands[i + 1]);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 1)));
+}
+BENCHMARK(BM_mul_checked_by_division);
+
+static void BM_mul_overflow(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; ++i) {
+            uint128_t product;
+            bool const overflow = mul_overflow(operands[i], operands[i + 1], product);
+            benchmark::DoNotOptimize(product);
+            benchmark::DoNotOptimize(overflow);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 1)));
+}
+BENCHMARK(BM_mul_overflow);
+
+static void BM_mul_sat(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; ++i) {
+            benchmark::DoNotOptimize(mul_sat(operands[i], operands[i + 1]));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 1)));
+}
+BENCHMARK(BM_mul_sat);
@@ -0,0 +1,109 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "uint128_bit.h"
+
+namespace {
+
+constexpr std::size_t operand_count = 1024;
+
+struct shift_operand {
+    uint128_t value;
+    uint32_t shift;
+};
+
+// random values and shift counts in [0, 128)
+auto make_operands() -> std::array<shift_operand, operand_count> {
+    std::mt19937_64 engine{ 0x0123456789abcdefULL };
+    std::array<shift_operand, operand_count> operands;
+    for (auto & [value, shift] : operands) {
+        value = uint128_t{ engine(), engine() };
+        shift = static_cast<uint32_t>(engine() & 127);
+    }
+    return operands;
+}
+
+}
+
+// shift count widened to uint128_t first, the previous operator<<(std::integral auto)
+static void BM_shift_left_widened(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (auto const & [value, shift] : operands) {
+            benchmark::DoNotOptimize(value << uint128_t{ shift });
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_shift_left_widened);
+
+static void BM_shift_left(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (auto const & [value, shift] : operands) {
+            benchmark::DoNotOptimize(value << shift);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_shift_left);
+
+static void BM_shift_right(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (auto const & [value, shift] : operands) {
+            benchmark::DoNotOptimize(value >> shift);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_shift_right);
+
+static void BM_rotl(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (auto const & [value, shift] : operands) {
+            benchmark::DoNotOptimize(rotl(value, static_cast<int>(shift)));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_rotl);
+
+// the same rotate from two shifts and an or
+static void BM_rotl_from_shifts(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (auto const & [value, shift] : operands) {
+            benchmark::DoNotOptimize((value << shift) | (value >> ((128 - shift) & 127)));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_rotl_from_shifts);
+
+static void BM_funnel_shift_left(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < operand_count; ++i) {
+            benchmark::DoNotOptimize(funnel_shift_left(operands[i].value, operands[i + 1].value, operands[i].shift));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (operand_count - 1)));
+}
+BENCHMARK(BM_funnel_shift_left);
+
+static void BM_shift_left_constant(benchmark::State & state) {
+    auto const operands = make_operands();
+    for (auto _ : state) {
+        for (auto const & operand : operands) {
+            benchmark::DoNotOptimize(shl<37>(operand.value));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operand_count));
+}
+BENCHMARK(BM_shift_left_constant);
@@ -0,0 +1,394 @@
+// Copyright(c) 2023 - present, Payton Wu (payton.wu@outlook.com) & the contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#if !defined(UINT128_T_INCLUDE_UINT128_DETAILS_UINT128_CHARCONV)
+#define UINT128_T_INCLUDE_UINT128_DETAILS_UINT128_CHARCONV
+
+#pragma once
+
+#include "uint128_intrinsics.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSSE3__)
+#   include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#   include <emmintrin.h>
+#endif
+
+namespace uint128::details {
+
+inline constexpr char digit_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+// "00" "01" ... "99"
+inline constexpr auto digit_pairs = [] {
+    std::array<char, 200> pairs{};
+    for (std::size_t i = 0; i < 100; ++i) {
+        pairs[2 * i] = static_cast<char>('0' + i / 10);
+        pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+    }
+    return pairs;
+}();
+
+// 10^19, the largest power of ten that fits in 64 bits
+inline constexpr std::uint64_t pow10_19 = 10000000000000000000ULL;
+
+// Number of base-`base` digits that always fit in 64 bits, i.e. the largest k with base^k <= 2^64 - 1.
+inline constexpr auto chunk_digits = [] {
+    std::array<std::uint8_t, 37> digits{};
+    for (std::uint64_t base = 2; base <= 36; ++base) {
+        std::uint64_t power = base;
+        std::uint8_t k = 1;
+        while (power <= UINT64_MAX / base) {
+            power *= base;
+            ++k;
+        }
+        digits[base] = k;
+    }
+    return digits;
+}();
+
+// Writes `value` in decimal right-aligned so that the last digit is at last[-1], two digits at a time.
+// Returns a pointer to the first digit written.
+constexpr auto write_decimal_backward(char * last, std::uint64_t value) noexcept -> char * {
+    while (value >= 100) {
+        auto const pair = static_cast<std::size_t>(value % 100) * 2;
+        value /= 100;
+        *--last = digit_pairs[pair + 1];
+        *--last = digit_pairs[pair];
+    }
+
+    if (value >= 10) {
+        auto const pair = static_cast<std::size_t>(value) * 2;
+        *--last = digit_pairs[pair + 1];
+        *--last = digit_pairs[pair];
+    } else {
+        *--last = static_cast<char>('0' + value);
+    }
+    return last;
+}
+
+// Writes exactly `width` digits of `value` in `base`, zero-padded, ending at last[-1].
+// Returns a pointer to the first digit written.
+constexpr auto write_digits_backward(char * last, std::uint64_t value, unsigned const base, std::size_t width) noexcept -> char * {
+    if (base == 10) {
+        while (width >= 2) {
+            auto const pair = static_cast<std::size_t>(value % 100) * 2;
+            value /= 100;
+            *--last = digit_pairs[pair + 1];
+            *--last = digit_pairs[pair];
+            width -= 2;
+        }
+    }
+
+    while (width--) {
+        *--last = digit_chars[value % base];
+        value /= base;
+    }
+    return last;
+}
+
+// Writes `value` in `base` without leading zeros, ending at last[-1].
+// Returns a pointer to the first digit written.
+constexpr auto write_u64_backward(char * last, std::uint64_t value, unsigned const base) noexcept -> char * {
+    if (base == 10) {
+        return write_decimal_backward(last, value);
+    }
+
+    do {
+        *--last = digit_chars[value % base];
+        value /= base;
+    } while (value);
+    return last;
+}
+
+// std::isspace in the "C" locale, usable in constant expressions.
+constexpr auto is_space(char const c) noexcept -> bool {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Value of the digit `c` in bases up to 36, or 255 if `c` is not a digit.
+constexpr auto digit_value(char const c) noexcept -> std::uint8_t {
+    if (c >= '0' && c <= '9') {
+        return static_cast<std::uint8_t>(c - '0');
+    }
+    if (c >= 'a' && c <= 'z') {
+        return static_cast<std::uint8_t>(c - 'a' + 10);
+    }
+    if (c >= 'A' && c <= 'Z') {
+        return static_cast<std::uint8_t>(c - 'A' + 10);
+    }
+    return 255;
+}
+
+// (upper:lower) = (upper:lower) * multiplier + addend.
+// Returns true if the result does not fit in 128 bits.
+constexpr auto mul_add_overflow(std::uint64_t & upper, std::uint64_t & lower, std::uint64_t const multiplier, std::uint64_t const addend) noexcept -> bool {
+    std::uint64_t lower_hi{};
+    std::uint64_t upper_hi{};
+    std::uint64_t const new_lower = umul64(lower, multiplier, lower_hi);
+    std::uint64_t new_upper = umul64(upper, multiplier, upper_hi);
+
+    new_upper += lower_hi;
+    bool overflow = upper_hi != 0 || new_upper < lower_hi;
+
+    lower = new_lower + addend;
+    std::uint64_t const carry = lower < addend;
+    upper = new_upper + carry;
+    overflow |= upper < carry;
+
+    return overflow;
+}
+
+// SWAR (SIMD within a register) parsing kernels.
+// Eight characters are loaded into one 64-bit word, first character in the lowest byte,
+// validated and converted with a handful of word-wide operations.
+
+// Loads 8 characters, p[0] into the least significant byte.
+constexpr auto load_chars_le(char const * const p) noexcept -> std::uint64_t {
+    if (!std::is_constant_evaluated()) {
+        std::uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        if constexpr (std::endian::native == std::endian::big) {
+            word = byteswap64(word);
+        }
+        return word;
+    }
+
+    std::uint64_t word = 0;
+    for (int i = 0; i < 8; ++i) {
+        word |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return word;
+}
+
+// True if all 8 characters are in '0'..'9'.
+constexpr auto is_eight_decimal_digits(std::uint64_t const chars) noexcept -> bool {
+    return ((chars & 0xf0f0f0f0f0f0f0f0) | (((chars + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) >> 4)) == 0x3333333333333333;
+}
+
+// Value of 8 decimal digits, chars[0] most significant. Precondition: is_eight_decimal_digits(chars).
+constexpr auto parse_eight_decimal_digits(std::uint64_t chars) noexcept -> std::uint64_t {
+    constexpr std::uint64_t mask = 0x000000ff000000ff;
+    constexpr std::uint64_t mul1 = 100 + (1000000ULL << 32);
+    constexpr std::uint64_t mul2 = 1 + (10000ULL << 32);
+
+    chars -= 0x3030303030303030;
+    chars = (chars * 10) + (chars >> 8);  // two digits per 16-bit lane
+    return (((chars & mask) * mul1) + (((chars >> 16) & mask) * mul2)) >> 32;
+}
+
+// Mask with the high bit set in every byte of `chars` that is a hexadecimal digit.
+constexpr auto hex_digit_mask(std::uint64_t const chars) noexcept -> std::uint64_t {
+    constexpr std::uint64_t ones = 0x0101010101010101;
+    constexpr std::uint64_t high = ones * 0x80;
+    constexpr std::uint64_t low7 = ones * 0x7f;
+
+    // high bit of each byte: m < byte < n, valid for bytes below 0x80
+    auto const between = [](std::uint64_t const x, std::uint64_t const m, std::uint64_t const n) {
+        return (ones * (127 + n) - (x & low7)) & ~x & ((x & low7) + ones * (127 - m)) & high;
+    };
+
+    std::uint64_t const folded = chars | (ones * 0x20);  // 'A'..'F' -> 'a'..'f', digits unchanged
+    return (between(chars, '0' - 1, '9' + 1) | between(folded, 'a' - 1, 'f' + 1)) & ~chars;
+}
+
+// Value of 8 hexadecimal digits, chars[0] most significant. Precondition: all 8 are hex digits.
+constexpr auto parse_eight_hex_digits(std::uint64_t const chars) noexcept -> std::uint64_t {
+    // '0'..'9' -> 0..9, 'a'..'f' / 'A'..'F' -> 1..6 + 9 (letters have bit 6 set)
+    std::uint64_t const nibbles = (chars & 0x0f0f0f0f0f0f0f0f) + ((chars >> 6) & 0x0101010101010101) * 9;
+
+    // merge neighbours, lower address is more significant: 8 nibbles -> 4 bytes -> 2 halfwords -> 1 word
+    std::uint64_t const bytes = ((nibbles & 0x000f000f000f000f) << 4) | ((nibbles >> 8) & 0x000f000f000f000f);
+    std::uint64_t const halves = ((bytes & 0x000000ff000000ff) << 8) | ((bytes >> 16) & 0x000000ff000000ff);
+    return ((halves & 0xffff) << 16) | ((halves >> 32) & 0xffff);
+}
+
+// Stores 8 characters, the least significant byte of `chars` into p[0].
+constexpr void store_chars_le(char * const p, std::uint64_t chars) noexcept {
+    if (!std::is_constant_evaluated()) {
+        if constexpr (std::endian::native == std::endian::big) {
+            chars = byteswap64(chars);
+        }
+        std::memcpy(p, &chars, sizeof(chars));
+        return;
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<char>((chars >> (8 * i)) & 0xff);
+    }
+}
+
+// Added to a nibble above 9 to turn '0' + nibble into a letter.
+constexpr auto hex_letter_offset(bool const uppercase) noexcept -> std::uint64_t {
+    return uppercase ? 'A' - '0' - 10 : 'a' - '0' - 10;
+}
+
+// The 8 hexadecimal digits of `value`, most significant digit in the lowest byte (see store_chars_le).
+constexpr auto format_eight_hex_digits(std::uint32_t const value, bool const uppercase) noexcept -> std::uint64_t {
+    // spread nibble i into byte i: 2 halfwords -> 4 bytes -> 8 nibbles
+    std::uint64_t nibbles = value;
+    nibbles = (nibbles | (nibbles << 16)) & 0x0000ffff0000ffff;
+    nibbles = (nibbles | (nibbles << 8)) & 0x00ff00ff00ff00ff;
+    nibbles = (nibbles | (nibbles << 4)) & 0x0f0f0f0f0f0f0f0f;
+
+    // bit 4 of nibble + 6 is set for nibbles above 9
+    std::uint64_t const letters = ((nibbles + 0x0606060606060606) >> 4) & 0x0101010101010101;
+    return byteswap64(nibbles + 0x3030303030303030 + letters * hex_letter_offset(uppercase));
+}
+
+// Writes exactly 32 hexadecimal digits of (upper:lower) to [out, out + 32).
+constexpr void write_hex32(char * const out, std::uint64_t const upper, std::uint64_t const lower, bool const uppercase) noexcept {
+#if defined(__SSE2__) || defined(_M_X64)
+    if (!std::is_constant_evaluated()) {
+        // bytes in memory order, most significant first; each byte becomes two characters
+        __m128i const bytes = _mm_set_epi64x(static_cast<long long>(byteswap64(lower)), static_cast<long long>(byteswap64(upper)));
+        __m128i const low_nibbles = _mm_set1_epi8(0x0f);
+        __m128i const high = _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibbles);
+        __m128i const low = _mm_and_si128(bytes, low_nibbles);
+
+        auto const to_ascii = [uppercase](__m128i const nibbles) {
+#   if defined(__SSSE3__)
+            __m128i const table = uppercase ? _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F')
+                                            : _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+            return _mm_shuffle_epi8(table, nibbles);
+#   else
+            __m128i const letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8(static_cast<char>(hex_letter_offset(uppercase))));
+            return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+#   endif
+        };
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), to_ascii(_mm_unpacklo_epi8(high, low)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), to_ascii(_mm_unpackhi_epi8(high, low)));
+        return;
+    }
+#endif
+
+    store_chars_le(out, format_eight_hex_digits(static_cast<std::uint32_t>(upper >> 32), uppercase));
+    store_chars_le(out + 8, format_eight_hex_digits(static_cast<std::uint32_t>(upper), uppercase));
+    store_chars_le(out + 16, format_eight_hex_digits(static_cast<std::uint32_t>(lower >> 32), uppercase));
+    store_chars_le(out + 24, format_eight_hex_digits(static_cast<std::uint32_t>(lower), uppercase));
+}
+
+// Writes the `count` lowest base-2^`shift` digits of (upper:lower) ending at last[-1],
+// for shift in [1, 5]. Every digit is a shift and a mask, no division.
+// Returns a pointer to the first digit written.
+constexpr auto write_pow2_backward(char * last, std::uint64_t upper, std::uint64_t lower, unsigned const shift, std::size_t count) noexcept -> char * {
+    std::uint64_t const mask = (std::uint64_t{ 1 } << shift) - 1;
+    while (count--) {
+        *--last = digit_chars[lower & mask];
+        lower = (lower >> shift) | (upper << (64 - shift));
+        upper >>= shift;
+    }
+    return last;
+}
+
+// The 8 binary digits of `byte`, most significant digit in the lowest byte (see store_chars_le).
+constexpr auto format_eight_binary_digits(std::uint64_t const byte) noexcept -> std::uint64_t {
+    // copy the byte into every lane, keep bit 7 - i in lane i, then move it to bit 0 of the lane
+    std::uint64_t const bits = (byte * 0x0101010101010101) & 0x0102040810204080;
+    return (((bits + 0x7f7f7f7f7f7f7f7f) >> 7) & 0x0101010101010101) + 0x3030303030303030;
+}
+
+// Writes exactly 128 binary digits of (upper:lower) to [out, out + 128).
+constexpr void write_binary128(char * out, std::uint64_t const upper, std::uint64_t const lower) noexcept {
+    for (int i = 56; i >= 0; i -= 8, out += 8) {
+        store_chars_le(out, format_eight_binary_digits((upper >> i) & 0xff));
+    }
+    for (int i = 56; i >= 0; i -= 8, out += 8) {
+        store_chars_le(out, format_eight_binary_digits((lower >> i) & 0xff));
+    }
+}
+
+struct parse_result {
+    char const * ptr;  // first character that is not a digit
+    bool overflow;     // the digits do not fit in 128 bits, (upper:lower) holds the value modulo 2^128
+};
+
+// Parses decimal digits starting at `first` into (upper:lower).
+// Runs of 16 / 8 digits are converted with SWAR, the remaining digits one at a time.
+constexpr auto parse_decimal(char const * const first, char const * const last, std::uint64_t & upper, std::uint64_t & lower) noexcept -> parse_result {
+    constexpr std::uint64_t pow10_8 = 100000000;
+    constexpr std::uint64_t pow10_16 = pow10_8 * pow10_8;
+
+    upper = lower = 0;
+    bool overflow = false;
+    char const * p = first;
+
+    while (last - p >= 16) {
+        std::uint64_t const high_chars = load_chars_le(p);
+        std::uint64_t const low_chars = load_chars_le(p + 8);
+        if (!is_eight_decimal_digits(high_chars) || !is_eight_decimal_digits(low_chars)) {
+            break;
+        }
+        std::uint64_t const digits = parse_eight_decimal_digits(high_chars) * pow10_8 + parse_eight_decimal_digits(low_chars);
+        overflow |= mul_add_overflow(upper, lower, pow10_16, digits);
+        p += 16;
+    }
+
+    if (last - p >= 8) {
+        std::uint64_t const chars = load_chars_le(p);
+        if (is_eight_decimal_digits(chars)) {
+            overflow |= mul_add_overflow(upper, lower, pow10_8, parse_eight_decimal_digits(chars));
+            p += 8;
+        }
+    }
+
+    // the SWAR runs stop fewer than 8 digits before the end of the digits
+    // (or of the input), so the rest fits in 64 bits
+    std::uint64_t digits = 0;
+    std::uint64_t scale = 1;
+    char const * const tail = p;
+    while (p != last && *p >= '0' && *p <= '9') {
+        digits = digits * 10 + static_cast<std::uint64_t>(*p - '0');
+        scale *= 10;
+        ++p;
+    }
+    if (p != tail) {
+        overflow |= mul_add_overflow(upper, lower, scale, digits);
+    }
+
+    return { p, overflow };
+}
+
+// Parses hexadecimal digits starting at `first` into (upper:lower).
+// Runs of 8 digits are converted with SWAR, the remaining digits one at a time.
+constexpr auto parse_hex(char const * const first, char const * const last, std::uint64_t & upper, std::uint64_t & lower) noexcept -> parse_result {
+    upper = lower = 0;
+    bool overflow = false;
+    char const * p = first;
+
+    auto const append = [&](std::uint64_t const digits, int const bits) {
+        overflow |= (upper >> (64 - bits)) != 0;
+        upper = (upper << bits) | (lower >> (64 - bits));
+        lower = (lower << bits) | digits;
+    };
+
+    while (last - p >= 8) {
+        std::uint64_t const chars = load_chars_le(p);
+        if (hex_digit_mask(chars) != 0x8080808080808080) {
+            break;
+        }
+        append(parse_eight_hex_digits(chars), 32);
+        p += 8;
+    }
+
+    for (; p != last; ++p) {
+        auto const digit = digit_value(*p);
+        if (digit >= 16) {
+            break;
+        }
+        append(digit, 4);
+    }
+
+    return { p, overflow };
+}
+
+}
+
+#endif //UINT128_T_INCLUDE_UINT128_DETAILS_UINT128_CHARCONV
@@ -0,0 +1,378 @@
+// Copyright(c) 2023 - present, Payton Wu (payton.wu@outlook.com) & the contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#if !defined(UINT128_T_INCLUDE_UINT128_DETAILS_UINT128_INTRINSICS)
+#define UINT128_T_INCLUDE_UINT128_DETAILS_UINT128_INTRINSICS
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#   include <intrin.h>
+#endif
+
+// Compiler / target capabilities used by the arithmetic kernels.
+//
+// UINT128_T_HAS_BUILTIN_INT128   the compiler provides unsigned __int128 (GCC, Clang).
+// UINT128_T_HAS_HARDWARE_MUL128  a 64x64->128 multiply maps to one or two hardware instructions.
+// UINT128_T_HAS_HARDWARE_DIV128  a 128/64->64 divide maps to one hardware instruction (x86-64 divq).
+#if defined(__SIZEOF_INT128__)
+#   define UINT128_T_HAS_BUILTIN_INT128 1
+#   define UINT128_T_HAS_HARDWARE_MUL128 1
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#   define UINT128_T_HAS_HARDWARE_MUL128 1
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#   define UINT128_T_HAS_HARDWARE_DIV128 1
+#elif defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920
+#   define UINT128_T_HAS_HARDWARE_DIV128 1
+#endif
+
+namespace uint128::details {
+
+#if defined(UINT128_T_HAS_BUILTIN_INT128)
+__extension__ typedef unsigned __int128 builtin_uint128_t;
+#endif
+
+// Reverses the bytes of a 64-bit word.
+constexpr auto byteswap64(std::uint64_t const value) noexcept -> std::uint64_t {
+#if defined(__cpp_lib_byteswap)
+    return std::byteswap(value);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(value);
+#else
+    std::uint64_t swapped = 0;
+    for (int i = 0; i < 8; ++i) {
+        swapped |= ((value >> (8 * i)) & 0xff) << (56 - 8 * i);
+    }
+    return swapped;
+#endif
+}
+
+// 64x64->128 multiply built from four 32x32->64 partial products.
+// Returns the low 64 bits, the high 64 bits are stored into `hi`.
+constexpr auto umul64_portable(std::uint64_t const a, std::uint64_t const b, std::uint64_t & hi) noexcept -> std::uint64_t {
+    std::uint64_t const a_lo = a & 0xffffffff;
+    std::uint64_t const a_hi = a >> 32;
+    std::uint64_t const b_lo = b & 0xffffffff;
+    std::uint64_t const b_hi = b >> 32;
+
+    std::uint64_t const lo_lo = a_lo * b_lo;
+    std::uint64_t const hi_lo = a_hi * b_lo;
+    std::uint64_t const lo_hi = a_lo * b_hi;
+    std::uint64_t const hi_hi = a_hi * b_hi;
+
+    // cannot overflow: (2^32 - 1) + 2 * (2^32 - 1)^2 < 2^64
+    std::uint64_t const cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+
+    hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    return (cross << 32) | (lo_lo & 0xffffffff);
+}
+
+// 64x64->128 multiply. Uses the hardware widening multiply when the compiler exposes one.
+constexpr auto umul64(std::uint64_t const a, std::uint64_t const b, std::uint64_t & hi) noexcept -> std::uint64_t {
+#if defined(UINT128_T_HAS_BUILTIN_INT128)
+    builtin_uint128_t const product = static_cast<builtin_uint128_t>(a) * b;
+    hi = static_cast<std::uint64_t>(product >> 64);
+    return static_cast<std::uint64_t>(product);
+#else
+    if (!std::is_constant_evaluated()) {
+#   if defined(_MSC_VER) && defined(_M_X64)
+        return _umul128(a, b, &hi);
+#   elif defined(_MSC_VER) && defined(_M_ARM64)
+        hi = __umulh(a, b);
+        return a * b;
+#   endif
+    }
+
+    return umul64_portable(a, b, hi);
+#endif
+}
+
+// Low 128 bits of a 128x128 multiply computed from 16 32x32->64 partial products.
+// Kept as the constant-evaluation / no-hardware path of uint128_t::operator*.
+// Returns the low 64 bits, the high 64 bits are stored into `hi`.
+constexpr auto mul128_limbs(std::uint64_t const lhs_upper, std::uint64_t const lhs_lower,
+                            std::uint64_t const rhs_upper, std::uint64_t const rhs_lower,
+                            std::uint64_t & hi) noexcept -> std::uint64_t {
+    // split values into 4 32-bit parts
+    std::uint64_t const top[4] = { lhs_upper >> 32, lhs_upper & 0xffffffff, lhs_lower >> 32, lhs_lower & 0xffffffff };
+    std::uint64_t const bottom[4] = { rhs_upper >> 32, rhs_upper & 0xffffffff, rhs_lower >> 32, rhs_lower & 0xffffffff };
+    std::uint64_t products[4][4]{};
+
+    // multiply each component of the values
+    for (int y = 3; y > -1; y--) {
+        for (int x = 3; x > -1; x--) {
+            products[3 - x][y] = top[x] * bottom[y];
+        }
+    }
+
+    // first row
+    std::uint64_t fourth32 = (products[0][3] & 0xffffffff);
+    std::uint64_t third32 = (products[0][2] & 0xffffffff) + (products[0][3] >> 32);
+    std::uint64_t second32 = (products[0][1] & 0xffffffff) + (products[0][2] >> 32);
+    std::uint64_t first32 = (products[0][0] & 0xffffffff) + (products[0][1] >> 32);
+
+    // second row
+    third32 += (products[1][3] & 0xffffffff);
+    second32 += (products[1][2] & 0xffffffff) + (products[1][3] >> 32);
+    first32 += (products[1][1] & 0xffffffff) + (products[1][2] >> 32);
+
+    // third row
+    second32 += (products[2][3] & 0xffffffff);
+    first32 += (products[2][2] & 0xffffffff) + (products[2][3] >> 32);
+
+    // fourth row
+    first32 += (products[3][3] & 0xffffffff);
+
+    // move carry to next digit
+    third32 += fourth32 >> 32;
+    second32 += third32 >> 32;
+    first32 += second32 >> 32;
+
+    // remove carry from current digit
+    fourth32 &= 0xffffffff;
+    third32 &= 0xffffffff;
+    second32 &= 0xffffffff;
+    first32 &= 0xffffffff;
+
+    // combine components
+    hi = (first32 << 32) | second32;
+    return (third32 << 32) | fourth32;
+}
+
+// Low 128 bits of a 128x128 multiply: one 64x64->128 multiply plus two 64-bit multiplies.
+// Returns the low 64 bits, the high 64 bits are stored into `hi`.
+constexpr auto mul128(std::uint64_t const lhs_upper, std::uint64_t const lhs_lower,
+                      std::uint64_t const rhs_upper, std::uint64_t const rhs_lower,
+                      std::uint64_t & hi) noexcept -> std::uint64_t {
+#if defined(UINT128_T_HAS_HARDWARE_MUL128)
+    if (!std::is_constant_evaluated()) {
+        std::uint64_t const lo = umul64(lhs_lower, rhs_lower, hi);
+        hi += lhs_upper * rhs_lower + lhs_lower * rhs_upper;
+        return lo;
+    }
+#endif
+
+    return mul128_limbs(lhs_upper, lhs_lower, rhs_upper, rhs_lower, hi);
+}
+
+// a * b + c + d, which always fits in 128 bits.
+// Returns the low 64 bits, the high 64 bits are stored into `hi`.
+constexpr auto umul64_add2(std::uint64_t const a, std::uint64_t const b, std::uint64_t const c, std::uint64_t const d, std::uint64_t & hi) noexcept -> std::uint64_t {
+#if defined(UINT128_T_HAS_BUILTIN_INT128)
+    builtin_uint128_t const result = static_cast<builtin_uint128_t>(a) * b + c + d;
+    hi = static_cast<std::uint64_t>(result >> 64);
+    return static_cast<std::uint64_t>(result);
+#else
+    std::uint64_t lo = umul64(a, b, hi);
+    lo += c;
+    hi += lo < c;
+    lo += d;
+    hi += lo < d;
+    return lo;
+#endif
+}
+
+// lhs * rhs + addend, 128x128->256 plus a 128-bit addend, schoolbook over 64-bit words.
+// Every step is a multiply and two adds that fit in 128 bits, so no separate carry pass.
+// Words of the result are stored least significant first.
+constexpr void mul128_wide_add(std::uint64_t const lhs_upper, std::uint64_t const lhs_lower,
+                               std::uint64_t const rhs_upper, std::uint64_t const rhs_lower,
+                               std::uint64_t const addend_upper, std::uint64_t const addend_lower,
+                               std::uint64_t (&product)[4]) noexcept {
+    // lhs_lower * rhs + addend
+    std::uint64_t carry{};
+    product[0] = umul64_add2(lhs_lower, rhs_lower, addend_lower, 0, carry);
+    std::uint64_t row_upper{};
+    std::uint64_t const row_middle = umul64_add2(lhs_lower, rhs_upper, addend_upper, carry, row_upper);
+
+    // lhs_upper * rhs, shifted by one word
+    product[1] = umul64_add2(lhs_upper, rhs_lower, row_middle, 0, carry);
+    product[2] = umul64_add2(lhs_upper, rhs_upper, row_upper, carry, product[3]);
+}
+
+// Full 128x128->256 multiply from four 64x64->128 multiplies.
+// Words of the product are stored least significant first.
+constexpr void mul128_wide(std::uint64_t const lhs_upper, std::uint64_t const lhs_lower,
+                           std::uint64_t const rhs_upper, std::uint64_t const rhs_lower,
+                           std::uint64_t (&product)[4]) noexcept {
+    mul128_wide_add(lhs_upper, lhs_lower, rhs_upper, rhs_lower, 0, 0, product);
+}
+
+// Branchless 128-bit shifts by a 64-bit count, counts of 128 or more give 0.
+// A double-word shift by count & 63 (shld / shrd) followed by a word select on count & 64
+// (cmov), as compilers lower unsigned __int128 shifts.
+// Return the low 64 bits, the high 64 bits are stored into `hi`.
+constexpr auto shl128(std::uint64_t const upper, std::uint64_t const lower, std::uint64_t const shift, std::uint64_t & hi) noexcept -> std::uint64_t {
+    std::uint64_t const keep = std::uint64_t{ 0 } - (shift < 128);
+#if defined(UINT128_T_HAS_BUILTIN_INT128)
+    builtin_uint128_t const value = ((static_cast<builtin_uint128_t>(upper) << 64) | lower) << (shift & 127);
+    hi = static_cast<std::uint64_t>(value >> 64) & keep;
+    return static_cast<std::uint64_t>(value) & keep;
+#else
+    // (lower >> 1) >> (63 - n) is lower >> (64 - n) without the undefined shift by 64
+    std::uint64_t const n = shift & 63;
+    std::uint64_t const shifted_upper = (upper << n) | ((lower >> 1) >> (63 - n));
+    std::uint64_t const shifted_lower = lower << n;
+    bool const wide = shift & 64;
+    hi = (wide ? shifted_lower : shifted_upper) & keep;
+    return (wide ? 0 : shifted_lower) & keep;
+#endif
+}
+
+constexpr auto shr128(std::uint64_t const upper, std::uint64_t const lower, std::uint64_t const shift, std::uint64_t & hi) noexcept -> std::uint64_t {
+    std::uint64_t const keep = std::uint64_t{ 0 } - (shift < 128);
+#if defined(UINT128_T_HAS_BUILTIN_INT128)
+    builtin_uint128_t const value = ((static_cast<builtin_uint128_t>(upper) << 64) | lower) >> (shift & 127);
+    hi = static_cast<std::uint64_t>(value >> 64) & keep;
+    return static_cast<std::uint64_t>(value) & keep;
+#else
+    std::uint64_t const n = shift & 63;
+    std::uint64_t const shifted_upper = upper >> n;
+    std::uint64_t const shifted_lower = (lower >> n) | ((upper << 1) << (63 - n));
+    bool const wide = shift & 64;
+    hi = (wide ? 0 : shifted_upper) & keep;
+    return (wide ? shifted_upper : shifted_lower) & keep;
+#endif
+}
+
+// 128-bit rotate left by count & 127: swap the words for counts of 64 and above, then two
+// double-word shifts.
+constexpr auto rotl128(std::uint64_t const upper, std::uint64_t const lower, std::uint64_t const count, std::uint64_t & hi) noexcept -> std::uint64_t {
+    bool const wide = count & 64;
+    std::uint64_t const a = wide ? lower : upper;
+    std::uint64_t const b = wide ? upper : lower;
+    std::uint64_t const n = count & 63;
+    hi = (a << n) | ((b >> 1) >> (63 - n));
+    return (b << n) | ((a >> 1) >> (63 - n));
+}
+
+// 128-bit add with carry out: { hi, lo } = lhs + rhs mod 2^128. Returns true if it wrapped.
+constexpr auto add128_overflow(std::uint64_t const lhs_upper, std::uint64_t const lhs_lower,
+                               std::uint64_t const rhs_upper, std::uint64_t const rhs_lower,
+                               std::uint64_t & hi, std::uint64_t & lo) noexcept -> bool {
+#if defined(UINT128_T_HAS_BUILTIN_INT128)
+    builtin_uint128_t result;
+    bool const overflow = __builtin_add_overflow((static_cast<builtin_uint128_t>(lhs_upper) << 64) | lhs_lower,
+                                                 (static_cast<builtin_uint128_t>(rhs_upper) << 64) | rhs_lower, &result);
+    hi = static_cast<std::uint64_t>(result >> 64);
+    lo = static_cast<std::uint64_t>(result);
+    return overflow;
+#else
+    lo = lhs_lower + rhs_lower;
+    std::uint64_t const carry = lo < lhs_lower;
+    std::uint64_t const sum = lhs_upper + rhs_upper;
+    hi = sum + carry;
+    return sum < lhs_upper || hi < sum;
+#endif
+}
+
+// 128-bit subtract with borrow out: { hi, lo } = lhs - rhs mod 2^128. Returns true if it wrapped.
+constexpr auto sub128_overflow(std::uint64_t const lhs_upper, std::uint64_t const lhs_lower,
+                               std::uint64_t const rhs_upper, std::uint64_t const rhs_lower,
+                               std::uint64_t & hi, std::uint64_t & lo) noexcept -> bool {
+#if defined(UINT128_T_HAS_BUILTIN_INT128)
+    builtin_uint128_t result;
+    bool const overflow = __builtin_sub_overflow((static_cast<builtin_uint128_t>(lhs_upper) << 64) | lhs_lower,
+                                                 (static_cast<builtin_uint128_t>(rhs_upper) << 64) | rhs_lower, &result);
+    hi = static_cast<std::uint64_t>(result >> 64);
+    lo = static_cast<std::uint64_t>(result);
+    return overflow;
+#else
+    lo = lhs_lower - rhs_lower;
+    std::uint64_t const borrow = lhs_lower < rhs_lower;
+    std::uint64_t const difference = lhs_upper - rhs_upper;
+    hi = difference - borrow;
+    return lhs_upper < rhs_upper || difference < borrow;
+#endif
+}
+
+// Low 128 bits of a 128x128 multiply. Returns true if the high 128 bits are not zero.
+// With at most one upper word set only one cross product is needed, and both set always overflows.
+constexpr auto mul128_overflow(std::uint64_t const lhs_upper, std::uint64_t const lhs_lower,
+                               std::uint64_t const rhs_upper, std::uint64_t const rhs_lower,
+                               std::uint64_t & hi, std::uint64_t & lo) noexcept -> bool {
+    if (lhs_upper && rhs_upper) {
+        lo = mul128(lhs_upper, lhs_lower, rhs_upper, rhs_lower, hi);
+        return true;
+    }
+
+    std::uint64_t cross_hi{};
+    std::uint64_t const cross = umul64(lhs_upper | rhs_upper, lhs_upper ? rhs_lower : lhs_lower, cross_hi);
+    lo = umul64(lhs_lower, rhs_lower, hi);
+    hi += cross;
+    return cross_hi != 0 || hi < cross;
+}
+
+// 128/64->64 divide of (u1:u0) by v with 32-bit digits (Knuth algorithm D, normalized divisor).
+// Precondition: u1 < v, so the quotient fits in 64 bits.
+// Returns the quotient, the remainder is stored into `r`.
+constexpr auto udiv128by64_portable(std::uint64_t const u1, std::uint64_t const u0, std::uint64_t v, std::uint64_t & r) noexcept -> std::uint64_t {
+    constexpr std::uint64_t b = std::uint64_t{ 1 } << 32;
+
+    int const s = std::countl_zero(v);
+    v <<= s;
+
+    std::uint64_t const vn1 = v >> 32;
+    std::uint64_t const vn0 = v & 0xffffffff;
+
+    std::uint64_t const un32 = s ? (u1 << s) | (u0 >> (64 - s)) : u1;
+    std::uint64_t const un10 = u0 << s;
+    std::uint64_t const un1 = un10 >> 32;
+    std::uint64_t const un0 = un10 & 0xffffffff;
+
+    // first quotient digit, corrected at most twice
+    std::uint64_t q1 = un32 / vn1;
+    std::uint64_t rhat = un32 - q1 * vn1;
+    while (q1 >= b || q1 * vn0 > b * rhat + un1) {
+        --q1;
+        rhat += vn1;
+        if (rhat >= b) {
+            break;
+        }
+    }
+
+    std::uint64_t const un21 = un32 * b + un1 - q1 * v;
+
+    // second quotient digit
+    std::uint64_t q0 = un21 / vn1;
+    rhat = un21 - q0 * vn1;
+    while (q0 >= b || q0 * vn0 > b * rhat + un0) {
+        --q0;
+        rhat += vn1;
+        if (rhat >= b) {
+            break;
+        }
+    }
+
+    r = (un21 * b + un0 - q0 * v) >> s;
+    return q1 * b + q0;
+}
+
+// 128/64->64 divide of (u1:u0) by v. Uses the hardware divide when available.
+// Precondition: u1 < v, so the quotient fits in 64 bits.
+// Returns the quotient, the remainder is stored into `r`.
+constexpr auto udiv128by64(std::uint64_t const u1, std::uint64_t const u0, std::uint64_t const v, std::uint64_t & r) noexcept -> std::uint64_t {
+#if defined(UINT128_T_HAS_HARDWARE_DIV128)
+    if (!std::is_constant_evaluated()) {
+#   if defined(__GNUC__) || defined(__clang__)
+        std::uint64_t q;
+        __asm__("divq %[v]" : "=a"(q), "=d"(r) : [v] "r"(v), "a"(u0), "d"(u1));
+        return q;
+#   else
+        return _udiv128(u1, u0, v, &r);
+#   endif
+    }
+#endif
+
+    return udiv128by64_portable(u1, u0, v, r);
+}
+
+}
+
+#endif //UINT128_T_INCLUDE_UINT128_DETAILS_UINT128_INTRINSICS
@@ -13,12 +13,12 @@
 
 namespace uint128::details {
 
+// Data members are public so that uint128_t is a structural type and can be used as a
+// non-type template parameter. Access them through uint128_t::upper() / lower().
 struct uint128_little_endian_storage {
-protected:
     std::uint64_t lower_{ 0 };
     std::uint64_t upper_{ 0 };
 
-public:
     constexpr uint128_little_endian_storage() = default;
 
     constexpr uint128_little_endian_storage(std::unsigned_integral auto const high, std::unsigned_integral auto const low) noexcept
@@ -42,12 +42,11 @@ public:
     }
 };
 
+// See uint128_little_endian_storage.
 struct uint128_big_endian_storage {
-protected:
     std::uint64_t upper_{ 0 };
     std::uint64_t lower_{ 0 };
 
-public:
     constexpr uint128_big_endian_storage() = default;
 
     constexpr uint128_big_endian_storage(std::unsigned_integral auto const high, std::unsigned_integral auto const low) noexcept
@@ -37,24 +37,36 @@
 #   error "C++20 or above is required"
 #endif
 
+#include "details/uint128_charconv.h"
+#include "details/uint128_intrinsics.h"
 #include "details/uint128_storage.h"
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <cassert>
 #include <cctype>
+#include <charconv>
 #include <compare>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <istream>
+#include <optional>
 #include <ostream>
 #include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 class uint128_t;
+struct uint128_div_t;
+
+constexpr auto to_chars(char * first, char * last, uint128_t value, int base = 10) -> std::to_chars_result;
 
 // Give uint128_t type traits
 //namespace std {
@@ -74,7 +86,8 @@ class uint128_t;
 //
 //}
 
-class [[nodiscard]] uint128_t : private uint128::details::uint128_storage {
+// Public inheritance keeps uint128_t a structural type (usable as a non-type template parameter).
+class [[nodiscard]] uint128_t : public uint128::details::uint128_storage {
 public:
     using uint128::details::uint128_storage::uint128_storage;
 
@@ -202,17 +215,62 @@ public:
         return { ~this->upper_, ~this->lower_ };
     }
 
+    // The 16 bytes of the value in `endian` order: one 16-byte store, byte-swapped if needed.
+    [[nodiscard]] constexpr auto to_bytes(std::endian const endian = std::endian::big) const noexcept -> std::array<std::byte, 16> {
+        bool const big = endian == std::endian::big;
+        auto const order = [endian](uint64_t const word) {
+            return endian == std::endian::native ? word : uint128::details::byteswap64(word);
+        };
+        std::array<uint64_t, 2> const words{ order(big ? this->upper_ : this->lower_), order(big ? this->lower_ : this->upper_) };
+        return std::bit_cast<std::array<std::byte, 16>>(words);
+    }
+
+    [[nodiscard]] static constexpr auto from_bytes(std::span<std::byte const, 16> const bytes, std::endian const endian = std::endian::big) noexcept -> uint128_t {
+        std::array<std::byte, 16> copy;
+        std::ranges::copy(bytes, std::begin(copy));
+        auto const order = [endian](uint64_t const word) {
+            return endian == std::endian::native ? word : uint128::details::byteswap64(word);
+        };
+        auto const words = std::bit_cast<std::array<uint64_t, 2>>(copy);
+        if (endian == std::endian::big) {
+            return { order(words[0]), order(words[1]) };
+        }
+        return { order(words[1]), order(words[0]) };
+    }
+
+    // Number of bytes without the leading zero bytes, 0 for 0.
+    [[nodiscard]] constexpr auto compact_size() const noexcept -> size_t {
+        return (this->bits() + 7u) / 8u;
+    }
+
+    // Writes the compact_size() significant bytes in `endian` order. Returns the number of bytes written.
+    constexpr auto to_bytes_compact(std::span<std::byte> const ret, std::endian const endian = std::endian::big) const noexcept -> size_t {
+        auto const size = this->compact_size();
+        assert(ret.size() >= size);
+
+        auto const bytes = this->to_bytes(endian);
+        std::copy_n(endian == std::endian::big ? std::end(bytes) - size : std::begin(bytes), size, std::begin(ret));
+        return size;
+    }
+
+    // Reads at most 16 significant bytes in `endian` order, as written by to_bytes_compact.
+    [[nodiscard]] static constexpr auto from_bytes_compact(std::span<std::byte const> const bytes, std::endian const endian = std::endian::big) noexcept -> uint128_t {
+        assert(bytes.size() <= 16);
+
+        std::array<std::byte, 16> padded{};
+        std::ranges::copy(bytes, endian == std::endian::big ? std::end(padded) - bytes.size() : std::begin(padded));
+        return from_bytes(padded, endian);
+    }
+
     constexpr void export_bits(std::span<uint8_t> const ret) const noexcept {
         assert(ret.size() >= 16);
 
-        convert_to_span_big_endian(this->upper_, ret);
-        convert_to_span_big_endian(this->lower_, ret.subspan(8));
+        std::ranges::copy(std::bit_cast<std::array<uint8_t, 16>>(this->to_bytes()), std::begin(ret));
     }
 
     constexpr void export_bits(std::vector<uint8_t> & ret) const noexcept {
-        convert_to_vector_big_endian(this->upper_, ret);
-        convert_to_vector_big_endian(this->lower_, ret);
-        assert(ret.size() == 16);
+        auto const bytes = std::bit_cast<std::array<uint8_t, 16>>(this->to_bytes());
+        ret.insert(std::end(ret), std::begin(bytes), std::end(bytes));
     }
 
     [[nodiscard]] constexpr auto export_bits() const noexcept -> std::vector<uint8_t> {
@@ -223,82 +281,50 @@ public:
     }
 
     constexpr auto export_bits_compact(std::span<uint8_t> const ret) const noexcept -> size_t {
-        assert(ret.size() >= 16);
-        auto tmp = export_bits_compact();
-        std::ranges::copy(tmp, std::begin(ret));
-        return tmp.size();
+        return export_bits_compact(std::endian::big, ret);
     }
 
     constexpr void export_bits_compact(std::vector<uint8_t> & ret) const noexcept {
-        auto tmp = export_bits_compact();
-        std::ranges::copy(tmp, std::back_inserter(ret));
+        export_bits_compact(std::endian::big, ret);
     }
 
     [[nodiscard]] constexpr auto export_bits_compact() const -> std::vector<uint8_t> {
-        std::vector<uint8_t> ret;
-        ret.reserve(16);
-        export_bits(ret);
-        assert(ret.size() == 16);
-
-        int i = 0;
-        while (i < 16 && ret[i] == 0) {
-            ++i;
-        }
-        ret.erase(std::begin(ret), std::next(std::begin(ret), i));
-
-        return ret;
+        return export_bits_compact(std::endian::big);
     }
 
     constexpr auto export_bits_compact(std::endian const endian, std::span<uint8_t> ret) const noexcept -> size_t {
         assert(ret.size() >= 16);
 
-        auto tmp = export_bits_compact(endian);
-        std::ranges::copy(tmp, std::begin(ret));
-
-        return tmp.size();
+        auto const size = this->compact_size();
+        auto const bytes = std::bit_cast<std::array<uint8_t, 16>>(this->to_bytes(endian));
+        std::copy_n(endian == std::endian::big ? std::end(bytes) - size : std::begin(bytes), size, std::begin(ret));
+        return size;
     }
 
     constexpr void export_bits_compact(std::endian const endian, std::vector<uint8_t> & ret) const noexcept {
-        auto tmp = export_bits_compact(endian);
-        std::ranges::copy(tmp, std::back_inserter(ret));
+        auto const size = this->compact_size();
+        auto const bytes = std::bit_cast<std::array<uint8_t, 16>>(this->to_bytes(endian));
+        auto const first = endian == std::endian::big ? std::end(bytes) - size : std::begin(bytes);
+        ret.insert(std::end(ret), first, first + size);
     }
 
     [[nodiscard]] constexpr auto export_bits_compact(std::endian const endian) const -> std::vector<uint8_t> {
-        auto res = export_bits_compact();
-        if (endian == std::endian::little) {
-            std::ranges::reverse(res);
-        }
-
-        return res;
+        std::vector<uint8_t> ret;
+        ret.reserve(16);
+        export_bits_compact(endian, ret);
+        return ret;
     }
 
     // Bit Shift Operators
+    // Branchless, see details::shl128 / shr128. Counts of 128 or more shift everything out;
+    // a count with upper_ set saturates to all ones, and negative integral counts convert to
+    // at least 2^63, so both give 0 like uint128_t{ rhs } does.
     constexpr auto operator<<(uint128_t const rhs) const noexcept -> uint128_t {
-        if (uint64_t const shift = rhs.lower_; static_cast<bool>(rhs.upper_) || (shift >= 128)) {
-            return { 0};
-        } else {
-            if (shift == 64) {
-                return { this->lower_, 0u };
-            }
-
-            if (shift == 0) {
-                return *this;
-            }
-
-            if (shift < 64) {
-                return { (this->upper_ << shift) + (this->lower_ >> (64 - shift)), this->lower_ << shift };
-            }
-
-            if ((128 > shift) && (shift > 64)) {
-                return { this->lower_ << (shift - 64), 0u };
-            }
-
-            return {0};
-        }
+        return this->shift_left(rhs.lower_ | (uint64_t{ 0 } - (rhs.upper_ != 0)));
     }
 
     constexpr auto operator<<(std::integral auto const rhs) const noexcept -> uint128_t {
-        return *this << uint128_t{ rhs };
+        return this->shift_left(static_cast<uint64_t>(rhs));
     }
 
     constexpr auto operator<<=(uint128_t const rhs) noexcept -> uint128_t & {
@@ -307,32 +333,16 @@ public:
     }
 
     constexpr auto operator<<=(std::integral auto const rhs) noexcept -> uint128_t & {
-        *this = *this << uint128_t{ rhs };
+        *this = *this << rhs;
         return *this;
     }
 
     constexpr auto operator>>(uint128_t const rhs) const noexcept -> uint128_t {
-        if (uint64_t const shift = rhs.lower_; static_cast<bool>(rhs.upper_) || (shift >= 128)) {
-            return { 0 };
-        } else {
-            if (shift == 64) {
-                return { 0u, this->upper_ };
-            }
-            if (shift == 0) {
-                return *this;
-            }
-            if (shift < 64) {
-                return { this->upper_ >> shift, (this->upper_ << (64 - shift)) + (this->lower_ >> shift) };
-            }
-            if ((128 > shift) && (shift > 64)) {
-                return { 0u, (this->upper_ >> (shift - 64)) };
-            }
-            return { 0 };
-        }
+        return this->shift_right(rhs.lower_ | (uint64_t{ 0 } - (rhs.upper_ != 0)));
     }
 
     constexpr auto operator>>(std::integral auto const rhs) const noexcept -> uint128_t {
-        return *this >> uint128_t{ rhs };
+        return this->shift_right(static_cast<uint64_t>(rhs));
     }
 
     constexpr auto operator>>=(uint128_t const rhs) noexcept -> uint128_t & {
@@ -341,7 +351,7 @@ public:
     }
 
     constexpr auto operator>>=(std::integral auto const rhs) noexcept -> uint128_t & {
-        *this = *this >> uint128_t{ rhs };
+        *this = *this >> rhs;
         return *this;
     }
 
@@ -419,53 +429,20 @@ public:
     }
 
     constexpr auto operator*(uint128_t const rhs) const noexcept -> uint128_t {
-        // split values into 4 32-bit parts
-        uint64_t const top[4] = { this->upper_ >> 32, this->upper_ & 0xffffffff, this->lower_ >> 32, this->lower_ & 0xffffffff };
-        uint64_t const bottom[4] = { rhs.upper_ >> 32, rhs.upper_ & 0xffffffff, rhs.lower_ >> 32, rhs.lower_ & 0xffffffff };
-        uint64_t products[4][4];
-
-        // multiply each component of the values
-        for (int y = 3; y > -1; y--) {
-            for (int x = 3; x > -1; x--) {
-                products[3 - x][y] = top[x] * bottom[y];
-            }
-        }
-
-        // first row
-        uint64_t fourth32 = (products[0][3] & 0xffffffff);
-        uint64_t third32 = (products[0][2] & 0xffffffff) + (products[0][3] >> 32);
-        uint64_t second32 = (products[0][1] & 0xffffffff) + (products[0][2] >> 32);
-        uint64_t first32 = (products[0][0] & 0xffffffff) + (products[0][1] >> 32);
-
-        // second row
-        third32 += (products[1][3] & 0xffffffff);
-        second32 += (products[1][2] & 0xffffffff) + (products[1][3] >> 32);
-        first32 += (products[1][1] & 0xffffffff) + (products[1][2] >> 32);
-
-        // third row
-        second32 += (products[2][3] & 0xffffffff);
-        first32 += (products[2][2] & 0xffffffff) + (products[2][3] >> 32);
-
-        // fourth row
-        first32 += (products[3][3] & 0xffffffff);
-
-        // move carry to next digit
-        third32 += fourth32 >> 32;
-        second32 += third32 >> 32;
-        first32 += second32 >> 32;
-
-        // remove carry from current digit
-        fourth32 &= 0xffffffff;
-        third32 &= 0xffffffff;
-        second32 &= 0xffffffff;
-        first32 &= 0xffffffff;
-
-        // combine components
-        return { (first32 << 32) | second32, (third32 << 32) | fourth32 };
+        uint64_t upper{};
+        uint64_t const lower = uint128::details::mul128(this->upper_, this->lower_, rhs.upper_, rhs.lower_, upper);
+        return { upper, lower };
     }
 
+    // 128x64: one widening multiply for the lower word plus one plain multiply for the upper.
     constexpr auto operator*(std::integral auto const & rhs) const noexcept -> uint128_t {
-        return *this * uint128_t{ rhs };
+        if (is_negative(rhs)) {
+            return *this * uint128_t{ rhs };
+        }
+
+        uint64_t upper{};
+        uint64_t const lower = uint128::details::umul64(this->lower_, static_cast<uint64_t>(rhs), upper);
+        return { upper + this->upper_ * static_cast<uint64_t>(rhs), lower };
     }
 
     constexpr auto operator*=(uint128_t const rhs) noexcept -> uint128_t & {
@@ -474,44 +451,111 @@ public:
     }
 
     constexpr auto operator*=(std::integral auto const rhs) noexcept -> uint128_t & {
-        return *this = *this * uint128_t(rhs);
+        return *this = *this * rhs;
     }
 
+    friend constexpr auto div(uint128_t lhs, uint128_t rhs) noexcept -> uint128_div_t;
+    friend constexpr auto divmod(uint128_t lhs, uint128_t rhs) -> uint128_div_t;
+    friend constexpr auto checked_divmod(uint128_t lhs, uint128_t rhs) noexcept -> std::optional<uint128_div_t>;
+    friend constexpr auto div(uint128_t lhs, std::integral auto rhs) noexcept -> uint128_div_t;
+    friend constexpr auto divmod(uint128_t lhs, std::integral auto rhs) -> uint128_div_t;
+
 private:
+    template <std::integral T>
+    [[nodiscard]] constexpr static auto is_negative(T const value) noexcept -> bool {
+        if constexpr (std::is_signed_v<T>) {
+            return value < 0;
+        } else {
+            return false;
+        }
+    }
+
+    // Counts of 128 or more give 0.
+    [[nodiscard]] constexpr auto shift_left(uint64_t const shift) const noexcept -> uint128_t {
+        uint64_t upper{};
+        uint64_t const lower = uint128::details::shl128(this->upper_, this->lower_, shift, upper);
+        return { upper, lower };
+    }
+
+    [[nodiscard]] constexpr auto shift_right(uint64_t const shift) const noexcept -> uint128_t {
+        uint64_t upper{};
+        uint64_t const lower = uint128::details::shr128(this->upper_, this->lower_, shift, upper);
+        return { upper, lower };
+    }
+
     [[nodiscard]] constexpr static auto divmod(uint128_t const lhs, uint128_t const rhs) -> std::pair<uint128_t, uint128_t> {
-        // Save some calculations /////////////////////
         if (rhs == uint128_t{ 0 }) {
             throw std::domain_error("Error: division or modulus by 0");
         }
 
-        if (rhs == uint128_t{ 1 }) {
-            return { lhs, uint128_t{ 0 } };
+        return divmod_nonzero(lhs, rhs);
+    }
+
+    [[nodiscard]] constexpr static auto divmod64(uint128_t const lhs, uint64_t const rhs) -> std::pair<uint128_t, uint64_t> {
+        if (rhs == 0) {
+            throw std::domain_error("Error: division or modulus by 0");
         }
 
-        if (lhs == rhs) {
-            return { uint128_t{ 1}, uint128_t{ 0 } };
+        return divmod64_nonzero(lhs, rhs);
+    }
+
+    // Precondition: rhs != 0
+    [[nodiscard]] constexpr static auto divmod64_nonzero(uint128_t const lhs, uint64_t const rhs) noexcept -> std::pair<uint128_t, uint64_t> {
+        assert(rhs != 0);
+
+        if (lhs.upper_ == 0) {
+            return { uint128_t{ lhs.lower_ / rhs }, lhs.lower_ % rhs };
         }
 
-        if ((lhs == uint128_t{ 0 }) || (lhs < rhs)) {
-            return { uint128_t{ 0 }, lhs };
+        // the quotient fits in 64 bits: a single 128/64 step
+        uint64_t r{};
+        if (lhs.upper_ < rhs) {
+            return { uint128_t{ uint128::details::udiv128by64(lhs.upper_, lhs.lower_, rhs, r) }, r };
         }
 
-        std::pair qr{ uint128_t{ 0 }, uint128_t{ 0 } };
-        for (uint8_t x = lhs.bits(); x > 0; x--) {
-            qr.first <<= uint128_t{ 1 };
-            qr.second <<= uint128_t{ 1 };
+        // two 128/64 steps: upper digit first, its remainder feeds the lower digit
+        uint64_t const q_upper = lhs.upper_ / rhs;
+        uint64_t const q_lower = uint128::details::udiv128by64(lhs.upper_ % rhs, lhs.lower_, rhs, r);
+        return { uint128_t{ q_upper, q_lower }, r };
+    }
 
-            if ((lhs >> (x - 1U)) & 1) {
-                ++qr.second;
-            }
+    // Precondition: rhs != 0
+    [[nodiscard]] constexpr static auto divmod_nonzero(uint128_t const lhs, uint128_t const rhs) noexcept -> std::pair<uint128_t, uint128_t> {
+        assert(rhs != uint128_t{ 0 });
 
-            if (qr.second >= rhs) {
-                qr.second -= rhs;
-                ++qr.first;
-            }
+        // 64-bit divisor /////////////////////////////
+        if (rhs.upper_ == 0) {
+            auto const [quot, rem] = divmod64_nonzero(lhs, rhs.lower_);
+            return { quot, uint128_t{ rem } };
+        }
+
+        // Save some calculations /////////////////////
+        if (lhs < rhs) {
+            return { uint128_t{ 0 }, lhs };
         }
-        return qr;
+
+        // 128-bit divisor ////////////////////////////
+        // The quotient fits in 64 bits. Estimate it from the normalized top 64 bits of the divisor
+        // (Hacker's Delight, divlu-based 128/128 division); the estimate is at most one too small.
+        int const shift = std::countl_zero(rhs.upper_);
+        uint64_t const divisor_upper = (rhs << shift).upper_;
+        uint128_t const half = lhs >> 1;
+
+        uint64_t r{};
+        uint64_t q = uint128::details::udiv128by64(half.upper_, half.lower_, divisor_upper, r);
+        q >>= 63 - shift;
+        if (q != 0) {
+            --q;
+        }
+
+        uint128_t rem = lhs - rhs * uint128_t{ q };
+        if (rem >= rhs) {
+            ++q;
+            rem -= rhs;
+        }
+        return { uint128_t{ q }, rem };
     }
+
     // do not use prefixes (0x, 0b, etc.)
     // if the input string is too long, only right most characters are read
     constexpr void init(char const * s, std::size_t len, uint8_t const base) {
@@ -520,7 +564,7 @@ private:
             return;
         }
 
-        while (len && *s && std::isspace(*s)) {
+        while (len && *s && uint128::details::is_space(*s)) {
             ++s;
             len--;
         }
@@ -556,17 +600,10 @@ private:
 
         std::size_t const max_len = std::min(len, MAX_LEN);
         std::size_t const starting_index = (MAX_LEN < len) ? (len - MAX_LEN) : 0;
-        std::size_t constexpr double_lower = sizeof(this->lower_) * 2;
-        std::size_t const lower_len = (max_len >= double_lower) ? double_lower : max_len;
-        std::size_t const upper_len = (max_len >= double_lower) ? (max_len - double_lower) : 0;
-
-        std::stringstream lower_s, upper_s;
-        upper_s << std::hex << std::string(s + starting_index, upper_len);
-        lower_s << std::hex << std::string(s + starting_index + upper_len, lower_len);
+        s += starting_index;
 
-        // should check for errors
-        upper_s >> this->upper_;
-        lower_s >> this->lower_;
+        // stops at the first character that is not a hex digit
+        (void)uint128::details::parse_hex(s, s + max_len, this->upper_, this->lower_);
     }
 
     constexpr void init_dec(char const * s, std::size_t const len) {
@@ -582,10 +619,8 @@ private:
         std::size_t const starting_index = (MAX_LEN < len) ? (len - MAX_LEN) : 0;
         s += starting_index;
 
-        for (std::size_t i = 0; *s && ('0' <= *s) && (*s <= '9') && (i < max_len); ++s, ++i) {
-            *this *= 10;
-            *this += *s - '0';
-        }
+        // stops at the first character that is not a digit, wraps modulo 2**128 like before
+        (void)uint128::details::parse_decimal(s, s + max_len, this->upper_, this->lower_);
     }
 
     constexpr void init_oct(char const * s, std::size_t const len) {
@@ -634,35 +669,17 @@ private:
         }
     }
 
-    constexpr static void convert_to_span_big_endian(uint64_t const val, std::span<uint8_t> ret) {
-        ret[0] = static_cast<uint8_t>(val >> 56);
-        ret[1] = static_cast<uint8_t>(val >> 48);
-        ret[2] = static_cast<uint8_t>(val >> 40);
-        ret[3] = static_cast<uint8_t>(val >> 32);
-        ret[4] = static_cast<uint8_t>(val >> 24);
-        ret[5] = static_cast<uint8_t>(val >> 16);
-        ret[6] = static_cast<uint8_t>(val >> 8);
-        ret[7] = static_cast<uint8_t>(val);
-    }
-
-    constexpr static void convert_to_vector_big_endian(uint64_t const val, std::vector<uint8_t> & ret) {
-        ret.push_back(static_cast<uint8_t>(val >> 56));
-        ret.push_back(static_cast<uint8_t>(val >> 48));
-        ret.push_back(static_cast<uint8_t>(val >> 40));
-        ret.push_back(static_cast<uint8_t>(val >> 32));
-        ret.push_back(static_cast<uint8_t>(val >> 24));
-        ret.push_back(static_cast<uint8_t>(val >> 16));
-        ret.push_back(static_cast<uint8_t>(val >> 8));
-        ret.push_back(static_cast<uint8_t>(val));
-    }
-
 public:
     constexpr auto operator/(uint128_t const rhs) const -> uint128_t {
         return divmod(*this, rhs).first;
     }
 
+    // 128/64: at most two hardware divides, see divmod64_nonzero.
     constexpr auto operator/(std::integral auto const rhs) const -> uint128_t {
-        return *this / uint128_t{ rhs };
+        if (is_negative(rhs)) {
+            return *this / uint128_t{ rhs };
+        }
+        return divmod64(*this, static_cast<uint64_t>(rhs)).first;
     }
 
     constexpr auto operator/=(uint128_t const rhs) -> uint128_t & {
@@ -670,7 +687,7 @@ public:
     }
 
     constexpr auto operator/=(std::integral auto const rhs) -> uint128_t & {
-        return *this = *this / uint128_t(rhs);
+        return *this = *this / rhs;
     }
 
     constexpr auto operator%(uint128_t const rhs) const -> uint128_t {
@@ -678,7 +695,10 @@ public:
     }
 
     constexpr auto operator%(std::integral auto const rhs) const -> uint128_t {
-        return *this % uint128_t(rhs);
+        if (is_negative(rhs)) {
+            return *this % uint128_t{ rhs };
+        }
+        return uint128_t{ divmod64(*this, static_cast<uint64_t>(rhs)).second };
     }
 
     constexpr auto operator%=(uint128_t const rhs) -> uint128_t & {
@@ -686,7 +706,7 @@ public:
     }
 
     constexpr auto operator%=(std::integral auto const rhs) -> uint128_t & {
-        return *this = *this % uint128_t{ rhs };
+        return *this = *this % rhs;
     }
 
     // Increment Operator
@@ -745,19 +765,17 @@ public:
             throw std::invalid_argument("Base must be in the range [2, 16]");
         }
 
+        // longest output: 128 binary digits
+        char buffer[128];
+        auto const digits_end = to_chars(std::begin(buffer), std::end(buffer), *this, base).ptr;
+        auto const digits = static_cast<std::size_t>(digits_end - std::begin(buffer));
+
         std::string out;
-        if (!(*this)) {
-            out = "0";
-        } else {
-            std::pair qr{ *this, uint128_t{0} };
-            do {
-                qr = divmod(qr.first, base);
-                out = "0123456789abcdef"[static_cast<uint8_t>(qr.second)] + out;
-            } while (qr.first);
-        }
-        if (out.size() < len) {
-            out = std::string(len - out.size(), '0') + out;
+        out.reserve(std::max<std::size_t>(digits, len));
+        if (digits < len) {
+            out.append(len - digits, '0');
         }
+        out.append(std::begin(buffer), digits_end);
         return out;
     }
 };
@@ -766,6 +784,287 @@ public:
 inline constexpr uint128_t uint128_0{ 0 };
 inline constexpr uint128_t uint128_1{ 1 };
 
+// Division
+// Quotient and remainder of a single division, like std::lldiv_t.
+struct uint128_div_t {
+    uint128_t quot;
+    uint128_t rem;
+
+    constexpr auto operator==(uint128_div_t const & rhs) const noexcept -> bool = default;
+};
+
+// Precondition: rhs != 0. Division by zero is undefined behavior, as with std::div.
+[[nodiscard]] constexpr auto div(uint128_t const lhs, uint128_t const rhs) noexcept -> uint128_div_t {
+    auto const [quot, rem] = uint128_t::divmod_nonzero(lhs, rhs);
+    return { quot, rem };
+}
+
+// Throws std::domain_error on division by zero, like operator/ and operator%.
+[[nodiscard]] constexpr auto divmod(uint128_t const lhs, uint128_t const rhs) -> uint128_div_t {
+    auto const [quot, rem] = uint128_t::divmod(lhs, rhs);
+    return { quot, rem };
+}
+
+// Returns std::nullopt on division by zero.
+[[nodiscard]] constexpr auto checked_divmod(uint128_t const lhs, uint128_t const rhs) noexcept -> std::optional<uint128_div_t> {
+    if (!rhs) {
+        return std::nullopt;
+    }
+
+    return div(lhs, rhs);
+}
+
+// Built-in divisors take the 128/64 path of operator/. The overloads also keep a call like
+// div(x, 10) from being ambiguous with div(int, int) and div(long, long) from <cstdlib>.
+[[nodiscard]] constexpr auto div(uint128_t const lhs, std::integral auto const rhs) noexcept -> uint128_div_t {
+    if (uint128_t::is_negative(rhs)) {
+        return div(lhs, uint128_t{ rhs });
+    }
+    auto const [quot, rem] = uint128_t::divmod64_nonzero(lhs, static_cast<uint64_t>(rhs));
+    return { quot, uint128_t{ rem } };
+}
+
+[[nodiscard]] constexpr auto divmod(uint128_t const lhs, std::integral auto const rhs) -> uint128_div_t {
+    if (uint128_t::is_negative(rhs)) {
+        return divmod(lhs, uint128_t{ rhs });
+    }
+    auto const [quot, rem] = uint128_t::divmod64(lhs, static_cast<uint64_t>(rhs));
+    return { quot, uint128_t{ rem } };
+}
+
+[[nodiscard]] constexpr auto checked_divmod(uint128_t const lhs, std::integral auto const rhs) noexcept -> std::optional<uint128_div_t> {
+    if (!rhs) {
+        return std::nullopt;
+    }
+
+    return div(lhs, rhs);
+}
+
+// Multiplication
+// Full 256-bit product, most significant half first like the uint128_t(upper, lower) constructor.
+struct uint128_wide_t {
+    uint128_t hi;
+    uint128_t lo;
+
+    constexpr auto operator==(uint128_wide_t const & rhs) const noexcept -> bool = default;
+};
+
+// lhs * rhs without truncation: four 64x64->128 multiplies.
+[[nodiscard]] constexpr auto mul_wide(uint128_t const lhs, uint128_t const rhs) noexcept -> uint128_wide_t {
+    std::uint64_t product[4]{};
+    uint128::details::mul128_wide(lhs.upper(), lhs.lower(), rhs.upper(), rhs.lower(), product);
+    return { { product[3], product[2] }, { product[1], product[0] } };
+}
+
+// High 128 bits of lhs * rhs, the half operator* drops.
+[[nodiscard]] constexpr auto mulhi(uint128_t const lhs, uint128_t const rhs) noexcept -> uint128_t {
+    return mul_wide(lhs, rhs).hi;
+}
+
+// lhs * rhs + addend, which cannot overflow 256 bits. The addend is folded into the
+// partial products instead of a separate 256-bit add.
+[[nodiscard]] constexpr auto mul_add_wide(uint128_t const lhs, uint128_t const rhs, uint128_t const addend) noexcept -> uint128_wide_t {
+    std::uint64_t product[4]{};
+    uint128::details::mul128_wide_add(lhs.upper(), lhs.lower(), rhs.upper(), rhs.lower(), addend.upper(), addend.lower(), product);
+    return { { product[3], product[2] }, { product[1], product[0] } };
+}
+
+// Checked arithmetic
+// Like __builtin_add_overflow and friends: `result` receives the wrapped value, the return
+// value tells whether it wrapped.
+
+[[nodiscard]] constexpr auto add_overflow(uint128_t const lhs, uint128_t const rhs, uint128_t & result) noexcept -> bool {
+    std::uint64_t upper{}, lower{};
+    bool const overflow = uint128::details::add128_overflow(lhs.upper(), lhs.lower(), rhs.upper(), rhs.lower(), upper, lower);
+    result = { upper, lower };
+    return overflow;
+}
+
+[[nodiscard]] constexpr auto sub_overflow(uint128_t const lhs, uint128_t const rhs, uint128_t & result) noexcept -> bool {
+    std::uint64_t upper{}, lower{};
+    bool const overflow = uint128::details::sub128_overflow(lhs.upper(), lhs.lower(), rhs.upper(), rhs.lower(), upper, lower);
+    result = { upper, lower };
+    return overflow;
+}
+
+[[nodiscard]] constexpr auto mul_overflow(uint128_t const lhs, uint128_t const rhs, uint128_t & result) noexcept -> bool {
+    std::uint64_t upper{}, lower{};
+    bool const overflow = uint128::details::mul128_overflow(lhs.upper(), lhs.lower(), rhs.upper(), rhs.lower(), upper, lower);
+    result = { upper, lower };
+    return overflow;
+}
+
+// Saturating arithmetic, like C++26 std::add_sat / std::sub_sat / std::mul_sat:
+// results clamp to [0, 2^128 - 1] instead of wrapping.
+
+[[nodiscard]] constexpr auto add_sat(uint128_t const lhs, uint128_t const rhs) noexcept -> uint128_t {
+    uint128_t result;
+    return add_overflow(lhs, rhs, result) ? uint128_t{ ~std::uint64_t{ 0 }, ~std::uint64_t{ 0 } } : result;
+}
+
+[[nodiscard]] constexpr auto sub_sat(uint128_t const lhs, uint128_t const rhs) noexcept -> uint128_t {
+    uint128_t result;
+    return sub_overflow(lhs, rhs, result) ? uint128_0 : result;
+}
+
+[[nodiscard]] constexpr auto mul_sat(uint128_t const lhs, uint128_t const rhs) noexcept -> uint128_t {
+    uint128_t result;
+    return mul_overflow(lhs, rhs, result) ? uint128_t{ ~std::uint64_t{ 0 }, ~std::uint64_t{ 0 } } : result;
+}
+
+// Character conversion
+// Same contract as std::to_chars / std::from_chars for unsigned integers:
+// base in [2, 36], lowercase digits, no prefixes, no allocation.
+
+// Returns { last, std::errc::value_too_large } if [first, last) cannot hold every digit.
+constexpr auto to_chars(char * const first, char * const last, uint128_t const value, int const base) -> std::to_chars_result {
+    assert(2 <= base && base <= 36);
+
+    // longest output: 128 binary digits
+    char buffer[128];
+    char * const buffer_end = std::end(buffer);
+    char * begin = buffer_end;
+    auto const radix = static_cast<unsigned>(base);
+
+    if (std::has_single_bit(radix)) {
+        // every digit is a group of bits: the digit count follows from the leading zeros
+        auto const shift = static_cast<unsigned>(std::countr_zero(radix));
+        auto const digits = std::max<std::size_t>((value.bits() + shift - 1) / shift, 1);
+        if (radix == 16) {
+            uint128::details::write_hex32(buffer_end - 32, value.upper(), value.lower(), false);
+        } else if (radix == 2) {
+            uint128::details::write_binary128(buffer, value.upper(), value.lower());
+        } else {
+            uint128::details::write_pow2_backward(buffer_end, value.upper(), value.lower(), shift, digits);
+        }
+        begin = buffer_end - digits;
+    } else if (!value.upper()) {
+        begin = uint128::details::write_u64_backward(buffer_end, value.lower(), radix);
+    } else if (radix == 10) {
+        // split into 10^19 chunks: at most 1 + 19 + 19 digits
+        uint128_t const chunk{ uint128::details::pow10_19 };
+        auto const [high, low] = div(value, chunk);
+        begin = uint128::details::write_digits_backward(begin, low.lower(), 10, 19);
+        if (high.upper()) {
+            auto const [top, middle] = div(high, chunk);
+            begin = uint128::details::write_digits_backward(begin, middle.lower(), 10, 19);
+            begin = uint128::details::write_decimal_backward(begin, top.lower());
+        } else {
+            begin = uint128::details::write_decimal_backward(begin, high.lower());
+        }
+    } else {
+        // split into chunks of as many digits as fit in 64 bits
+        std::size_t const width = uint128::details::chunk_digits[radix];
+        uint64_t power = 1;
+        for (std::size_t i = 0; i < width; ++i) {
+            power *= radix;
+        }
+
+        uint128_t rest = value;
+        while (rest.upper()) {
+            auto const [quot, rem] = div(rest, uint128_t{ power });
+            begin = uint128::details::write_digits_backward(begin, rem.lower(), radix, width);
+            rest = quot;
+        }
+        begin = uint128::details::write_u64_backward(begin, rest.lower(), radix);
+    }
+
+    auto const size = buffer_end - begin;
+    if (last - first < size) {
+        return { last, std::errc::value_too_large };
+    }
+
+    return { std::copy(begin, buffer_end, first), std::errc{} };
+}
+
+// Writes `value` as hexadecimal digits, zero-padded to at least `width` digits
+// (32 gives the fixed-width form of every value), without allocating.
+// Returns { last, std::errc::value_too_large } if [first, last) cannot hold every digit.
+constexpr auto to_hex_chars(char * const first, char * const last, uint128_t const value, std::size_t const width = 32, bool const uppercase = false) -> std::to_chars_result {
+    auto const digits = std::max<std::size_t>((value.bits() + 3) / 4, 1);
+    auto const size = std::max(digits, width);
+    if (static_cast<std::size_t>(last - first) < size) {
+        return { last, std::errc::value_too_large };
+    }
+
+    if (size >= 32) {
+        char * const digits_first = std::fill_n(first, size - 32, '0');
+        uint128::details::write_hex32(digits_first, value.upper(), value.lower(), uppercase);
+        return { digits_first + 32, std::errc{} };
+    }
+
+    // the 32 digit form is already zero-padded, keep its last `size` digits
+    char buffer[32];
+    uint128::details::write_hex32(buffer, value.upper(), value.lower(), uppercase);
+    return { std::copy(std::end(buffer) - size, std::end(buffer), first), std::errc{} };
+}
+
+// No leading whitespace, sign or prefix is accepted. On error `value` is left unmodified:
+// { first, std::errc::invalid_argument } if there is no digit,
+// { end of the digits, std::errc::result_out_of_range } if the number does not fit in 128 bits.
+constexpr auto from_chars(char const * const first, char const * const last, uint128_t & value, int const base = 10) -> std::from_chars_result {
+    assert(2 <= base && base <= 36);
+
+    auto const radix = static_cast<unsigned>(base);
+    std::size_t const width = uint128::details::chunk_digits[radix];
+
+    uint64_t upper = 0;
+    uint64_t lower = 0;
+    bool overflow = false;
+
+    if (radix == 10 || radix == 16) {
+        auto const res = radix == 10 ? uint128::details::parse_decimal(first, last, upper, lower)
+                                     : uint128::details::parse_hex(first, last, upper, lower);
+        if (res.ptr == first) {
+            return { first, std::errc::invalid_argument };
+        }
+
+        if (res.overflow) {
+            return { res.ptr, std::errc::result_out_of_range };
+        }
+
+        value = uint128_t{ upper, lower };
+        return { res.ptr, std::errc{} };
+    }
+
+    // accumulate up to `width` digits in 64 bits, then fold them into the 128-bit result
+    char const * p = first;
+    while (p != last) {
+        uint64_t digits = 0;
+        uint64_t scale = 1;
+        std::size_t n = 0;
+        for (; p != last && n < width; ++p, ++n) {
+            auto const digit = uint128::details::digit_value(*p);
+            if (digit >= radix) {
+                break;
+            }
+            digits = digits * radix + digit;
+            scale *= radix;
+        }
+
+        if (n == 0) {
+            break;
+        }
+
+        overflow |= uint128::details::mul_add_overflow(upper, lower, scale, digits);
+
+        if (n < width) {
+            break;
+        }
+    }
+
+    if (p == first) {
+        return { first, std::errc::invalid_argument };
+    }
+
+    if (overflow) {
+        return { p, std::errc::result_out_of_range };
+    }
+
+    value = uint128_t{ upper, lower };
+    return { p, std::errc{} };
+}
+
 // lhs type T as first argument
 // If the output is not a bool, casts to type T
 
@@ -863,14 +1162,153 @@ constexpr auto operator%=(T & lhs, uint128_t const rhs) -> T & {
 }
 
 // IO Operator
+// Formats into a stack buffer and writes to the streambuf once, like the inserters for
+// built-in integers: basefield (decimal when unset), showbase, uppercase, width, fill and
+// adjustfield (left, right, internal) are honored and width is reset to 0.
 inline std::ostream & operator<<(std::ostream & stream, uint128_t const rhs) {
-    if (stream.flags() & std::ios_base::oct) {
-        stream << rhs.str(8);
-    } else if (stream.flags() & std::ios_base::dec) {
-        stream << rhs.str(10);
-    } else if (stream.flags() & std::ios_base::hex) {
-        stream << rhs.str(16);
+    std::ostream::sentry const guard(stream);
+    if (!guard) {
+        return stream;
+    }
+
+    auto const flags = stream.flags();
+    auto const basefield = flags & std::ios_base::basefield;
+    bool const uppercase = (flags & std::ios_base::uppercase) != 0;
+
+    char prefix[2]{};
+    std::size_t prefix_size = 0;
+    char digits[128];
+    char * digits_end = nullptr;
+    if (basefield == std::ios_base::hex) {
+        if ((flags & std::ios_base::showbase) && rhs) {
+            prefix[prefix_size++] = '0';
+            prefix[prefix_size++] = uppercase ? 'X' : 'x';
+        }
+        digits_end = to_hex_chars(std::begin(digits), std::end(digits), rhs, 1, uppercase).ptr;
+    } else if (basefield == std::ios_base::oct) {
+        if ((flags & std::ios_base::showbase) && rhs) {
+            prefix[prefix_size++] = '0';
+        }
+        digits_end = to_chars(std::begin(digits), std::end(digits), rhs, 8).ptr;
+    } else {
+        digits_end = to_chars(std::begin(digits), std::end(digits), rhs, 10).ptr;
+    }
+
+    auto const size = static_cast<std::streamsize>(prefix_size) + (digits_end - std::begin(digits));
+    std::streamsize padding = stream.width() > size ? stream.width() - size : 0;
+    stream.width(0);
+
+    auto * const buf = stream.rdbuf();
+    bool ok = true;
+    auto const pad = [&] {
+        for (; padding > 0 && ok; --padding) {
+            ok = !std::ostream::traits_type::eq_int_type(buf->sputc(stream.fill()), std::ostream::traits_type::eof());
+        }
+    };
+
+    auto const adjustfield = flags & std::ios_base::adjustfield;
+    if (adjustfield != std::ios_base::left && adjustfield != std::ios_base::internal) {
+        pad();
+    }
+    ok = ok && buf->sputn(prefix, static_cast<std::streamsize>(prefix_size)) == static_cast<std::streamsize>(prefix_size);
+    if (adjustfield == std::ios_base::internal) {
+        pad();
+    }
+    ok = ok && buf->sputn(digits, digits_end - std::begin(digits)) == digits_end - std::begin(digits);
+    pad();
+
+    if (!ok) {
+        stream.setstate(std::ios_base::badbit);
+    }
+    return stream;
+}
+
+// Reads digits straight from the streambuf, like the extractors for built-in integers.
+// The base comes from basefield; when it is unset the prefix decides ("0x" hexadecimal,
+// "0" octal, decimal otherwise). A "0x" prefix is also accepted with std::hex and a leading '+'
+// is skipped. Sets failbit and stores 0 if there is no digit (a "0x" prefix alone included), and sets failbit and stores
+// the maximum value if the number does not fit in 128 bits.
+inline std::istream & operator>>(std::istream & stream, uint128_t & rhs) {
+    std::istream::sentry const guard(stream);
+    if (!guard) {
+        return stream;
+    }
+
+    using traits = std::istream::traits_type;
+    auto * const buf = stream.rdbuf();
+    auto c = buf->sgetc();
+    auto const next = [&] {
+        c = buf->snextc();
+    };
+    auto const is = [&](char const ch) {
+        return traits::eq_int_type(c, traits::to_int_type(ch));
+    };
+
+    if (is('+')) {
+        next();
+    }
+
+    auto const basefield = stream.flags() & std::ios_base::basefield;
+    unsigned base = basefield == std::ios_base::oct ? 8 : basefield == std::ios_base::hex ? 16 : 10;
+
+    // a leading zero counts as a digit even if it turns out to start a prefix
+    bool digits = false;
+    if ((basefield == 0 || base == 16) && is('0')) {
+        digits = true;
+        next();
+        if (is('x') || is('X')) {
+            // the zero was the prefix, hexadecimal digits must follow
+            digits = false;
+            base = 16;
+            next();
+        } else if (basefield == 0) {
+            base = 8;
+        }
+    }
+
+    // accumulate up to `width` digits in 64 bits, then fold them into the 128-bit result
+    std::size_t const width = uint128::details::chunk_digits[base];
+    uint64_t upper = 0;
+    uint64_t lower = 0;
+    bool overflow = false;
+    bool more = true;
+    while (more) {
+        uint64_t chunk = 0;
+        uint64_t scale = 1;
+        std::size_t n = 0;
+        for (; n < width; ++n, next()) {
+            if (traits::eq_int_type(c, traits::eof())) {
+                more = false;
+                break;
+            }
+            auto const digit = uint128::details::digit_value(traits::to_char_type(c));
+            if (digit >= base) {
+                more = false;
+                break;
+            }
+            chunk = chunk * base + digit;
+            scale *= base;
+        }
+        if (n) {
+            digits = true;
+            overflow |= uint128::details::mul_add_overflow(upper, lower, scale, chunk);
+        }
+    }
+
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    if (traits::eq_int_type(c, traits::eof())) {
+        state |= std::ios_base::eofbit;
+    }
+    if (!digits) {
+        rhs = uint128_0;
+        state |= std::ios_base::failbit;
+    } else if (overflow) {
+        rhs = uint128_t{ UINT64_MAX, UINT64_MAX };
+        state |= std::ios_base::failbit;
+    } else {
+        rhs = uint128_t{ upper, lower };
     }
+    stream.setstate(state);
     return stream;
 }
 
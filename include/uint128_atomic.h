@@ -0,0 +1,300 @@
+// Copyright(c) 2023 - present, Payton Wu (payton.wu@outlook.com) & the contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+// Lock-free atomic uint128_t built on a 16-byte compare-and-swap.
+//
+//   atomic_uint128 sequence{ 0 };
+//   auto const ticket = sequence.fetch_add(1);
+//
+// The compare-and-swap is
+//   x86-64   lock cmpxchg16b (GCC / Clang inline assembly, _InterlockedCompareExchange128 on MSVC).
+//            Every x86-64 CPU since 2006 has cmpxchg16b; Windows 8.1 and later require it.
+//   AArch64  caspal with LSE (-march=armv8.1-a or later), otherwise an ldaxp / stlxp loop.
+// On other targets atomic_uint128 falls back to a table of spinlocks indexed by the address
+// of the object, so its size and alignment (16 / 16) are the same everywhere;
+// atomic_uint128::is_always_lock_free tells which one is in use.
+//
+// Every operation is sequentially consistent, the memory_order arguments are accepted for
+// compatibility with std::atomic. load() is a compare-and-swap as well, so it takes the cache
+// line exclusive: readers contend with writers and with each other. All other operations are
+// a single compare-and-swap when uncontended.
+//
+// std::atomic<uint128_t> still works, but GCC and Clang route it through libatomic (which may
+// take a lock) and MSVC always takes a lock.
+
+#if !defined(UINT128_ATOMIC_H)
+#define UINT128_ATOMIC_H  // NOLINT(clang-diagnostic-unused-macros)
+#pragma once
+
+#include "uint128.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#   include <intrin.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__aarch64__))
+#   define UINT128_T_HAS_CAS128 1
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#   define UINT128_T_HAS_CAS128 1
+#endif
+
+namespace uint128::details {
+
+struct alignas(64) cas128_lock {
+    std::atomic_flag flag;
+};
+
+// Spinlock guarding the 16 bytes at `target`, one cache line per lock.
+inline auto cas128_lock_for(void const * const target) noexcept -> std::atomic_flag & {
+    static cas128_lock locks[64];
+    return locks[(reinterpret_cast<std::uintptr_t>(target) >> 4) & 63].flag;
+}
+
+// Compare-and-swap of target[0..1] under a spinlock. Every access to the words goes through
+// std::atomic_ref, so lock-free readers of a single word (see load_words_relaxed) do not race.
+inline auto cas128_locked(std::uint64_t * const target, std::uint64_t (&expected)[2], std::uint64_t const (&desired)[2]) noexcept -> bool {
+    auto & lock = cas128_lock_for(target);
+    while (lock.test_and_set(std::memory_order_acquire)) {
+        while (lock.test(std::memory_order_relaxed)) {
+        }
+    }
+
+    std::atomic_ref<std::uint64_t> const lo{ target[0] };
+    std::atomic_ref<std::uint64_t> const hi{ target[1] };
+    std::uint64_t const old_lo = lo.load(std::memory_order_relaxed);
+    std::uint64_t const old_hi = hi.load(std::memory_order_relaxed);
+    bool const equal = old_lo == expected[0] && old_hi == expected[1];
+    if (equal) {
+        lo.store(desired[0], std::memory_order_relaxed);
+        hi.store(desired[1], std::memory_order_relaxed);
+    } else {
+        expected[0] = old_lo;
+        expected[1] = old_hi;
+    }
+
+    lock.clear(std::memory_order_release);
+    return equal;
+}
+
+// Atomically replaces target[0..1] (16-byte aligned, low word first) with `desired` if it equals
+// `expected`. Otherwise stores the current value into `expected`. Sequentially consistent.
+inline auto cas128(std::uint64_t * const target, std::uint64_t (&expected)[2], std::uint64_t const (&desired)[2]) noexcept -> bool {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+    bool equal;
+    __asm__ __volatile__("lock cmpxchg16b %[target]"
+                         : [target] "+m"(*reinterpret_cast<builtin_uint128_t *>(target)), "=@ccz"(equal), "+a"(expected[0]), "+d"(expected[1])
+                         : "b"(desired[0]), "c"(desired[1])
+                         : "memory");
+    return equal;
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__) && defined(__ARM_FEATURE_ATOMICS)
+    // casp needs even / odd register pairs
+    register std::uint64_t old_lo __asm__("x0") = expected[0];
+    register std::uint64_t old_hi __asm__("x1") = expected[1];
+    register std::uint64_t new_lo __asm__("x2") = desired[0];
+    register std::uint64_t new_hi __asm__("x3") = desired[1];
+    __asm__ __volatile__("caspal %[old_lo], %[old_hi], %[new_lo], %[new_hi], %[target]"
+                         : [old_lo] "+r"(old_lo), [old_hi] "+r"(old_hi), [target] "+Q"(*reinterpret_cast<builtin_uint128_t *>(target))
+                         : [new_lo] "r"(new_lo), [new_hi] "r"(new_hi)
+                         : "memory");
+    bool const equal = old_lo == expected[0] && old_hi == expected[1];
+    expected[0] = old_lo;
+    expected[1] = old_hi;
+    return equal;
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    // a failed comparison stores the observed value back, ldaxp alone is not single-copy atomic
+    std::uint64_t old_lo;
+    std::uint64_t old_hi;
+    std::uint32_t failed;
+    __asm__ __volatile__("1: ldaxp %[old_lo], %[old_hi], %[target]\n"
+                         "   cmp %[old_lo], %[expected_lo]\n"
+                         "   ccmp %[old_hi], %[expected_hi], #0, eq\n"
+                         "   b.ne 2f\n"
+                         "   stlxp %w[failed], %[desired_lo], %[desired_hi], %[target]\n"
+                         "   cbnz %w[failed], 1b\n"
+                         "   b 3f\n"
+                         "2: stlxp %w[failed], %[old_lo], %[old_hi], %[target]\n"
+                         "   cbnz %w[failed], 1b\n"
+                         "3:"
+                         : [old_lo] "=&r"(old_lo), [old_hi] "=&r"(old_hi), [failed] "=&r"(failed),
+                           [target] "+Q"(*reinterpret_cast<builtin_uint128_t *>(target))
+                         : [expected_lo] "r"(expected[0]), [expected_hi] "r"(expected[1]),
+                           [desired_lo] "r"(desired[0]), [desired_hi] "r"(desired[1])
+                         : "cc", "memory");
+    bool const equal = old_lo == expected[0] && old_hi == expected[1];
+    expected[0] = old_lo;
+    expected[1] = old_hi;
+    return equal;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    return _InterlockedCompareExchange128(reinterpret_cast<__int64 volatile *>(target), static_cast<__int64>(desired[1]),
+                                          static_cast<__int64>(desired[0]), reinterpret_cast<__int64 *>(expected)) != 0;
+#else
+    return cas128_locked(target, expected, desired);
+#endif
+}
+
+// Reads both words without a compare-and-swap. The pair may be torn, it is only a first guess
+// for a compare-and-swap loop.
+inline void load_words_relaxed(std::uint64_t * const target, std::uint64_t (&words)[2]) noexcept {
+    words[0] = std::atomic_ref<std::uint64_t>{ target[0] }.load(std::memory_order_relaxed);
+    words[1] = std::atomic_ref<std::uint64_t>{ target[1] }.load(std::memory_order_relaxed);
+}
+
+}
+
+class atomic_uint128 {
+public:
+    using value_type = uint128_t;
+    using difference_type = uint128_t;
+
+#if defined(UINT128_T_HAS_CAS128)
+    static constexpr bool is_always_lock_free = true;
+#else
+    static constexpr bool is_always_lock_free = false;
+#endif
+
+    constexpr atomic_uint128() noexcept = default;
+
+    constexpr atomic_uint128(uint128_t const desired) noexcept  // NOLINT(google-explicit-constructor)
+        : words_{ desired.lower(), desired.upper() } {
+    }
+
+    atomic_uint128(atomic_uint128 const &) = delete;
+    auto operator=(atomic_uint128 const &) -> atomic_uint128 & = delete;
+
+    void operator=(uint128_t const desired) noexcept {
+        this->store(desired);
+    }
+
+    operator uint128_t() const noexcept {  // NOLINT(google-explicit-constructor)
+        return this->load();
+    }
+
+    [[nodiscard]] auto is_lock_free() const noexcept -> bool {
+        return is_always_lock_free;
+    }
+
+    [[nodiscard]] auto load(std::memory_order = std::memory_order_seq_cst) const noexcept -> uint128_t {
+        // compare against zero and write back what is there
+        std::uint64_t expected[2]{};
+        std::uint64_t const desired[2]{};
+        uint128::details::cas128(this->words_, expected, desired);
+        return { expected[1], expected[0] };
+    }
+
+    void store(uint128_t const desired, std::memory_order const order = std::memory_order_seq_cst) noexcept {
+        static_cast<void>(this->exchange(desired, order));
+    }
+
+    auto exchange(uint128_t const desired, std::memory_order = std::memory_order_seq_cst) noexcept -> uint128_t {
+        return this->update([desired](uint128_t) { return desired; });
+    }
+
+    auto compare_exchange_strong(uint128_t & expected, uint128_t const desired, std::memory_order = std::memory_order_seq_cst) noexcept -> bool {
+        std::uint64_t expected_words[2]{ expected.lower(), expected.upper() };
+        std::uint64_t const desired_words[2]{ desired.lower(), desired.upper() };
+        if (uint128::details::cas128(this->words_, expected_words, desired_words)) {
+            return true;
+        }
+        expected = { expected_words[1], expected_words[0] };
+        return false;
+    }
+
+    auto compare_exchange_strong(uint128_t & expected, uint128_t const desired, std::memory_order const success, std::memory_order) noexcept -> bool {
+        return this->compare_exchange_strong(expected, desired, success);
+    }
+
+    // never fails spuriously
+    auto compare_exchange_weak(uint128_t & expected, uint128_t const desired, std::memory_order const order = std::memory_order_seq_cst) noexcept -> bool {
+        return this->compare_exchange_strong(expected, desired, order);
+    }
+
+    auto compare_exchange_weak(uint128_t & expected, uint128_t const desired, std::memory_order const success, std::memory_order) noexcept -> bool {
+        return this->compare_exchange_strong(expected, desired, success);
+    }
+
+    auto fetch_add(uint128_t const arg, std::memory_order = std::memory_order_seq_cst) noexcept -> uint128_t {
+        return this->update([arg](uint128_t const value) { return value + arg; });
+    }
+
+    auto fetch_sub(uint128_t const arg, std::memory_order = std::memory_order_seq_cst) noexcept -> uint128_t {
+        return this->update([arg](uint128_t const value) { return value - arg; });
+    }
+
+    auto fetch_and(uint128_t const arg, std::memory_order = std::memory_order_seq_cst) noexcept -> uint128_t {
+        return this->update([arg](uint128_t const value) { return value & arg; });
+    }
+
+    auto fetch_or(uint128_t const arg, std::memory_order = std::memory_order_seq_cst) noexcept -> uint128_t {
+        return this->update([arg](uint128_t const value) { return value | arg; });
+    }
+
+    auto fetch_xor(uint128_t const arg, std::memory_order = std::memory_order_seq_cst) noexcept -> uint128_t {
+        return this->update([arg](uint128_t const value) { return value ^ arg; });
+    }
+
+    // Like std::atomic, the compound assignments and prefix ++ / -- return the new value and
+    // postfix ++ / -- the previous one. uint128_t is [[nodiscard]]: cast an unused result to void.
+    auto operator+=(uint128_t const arg) noexcept -> uint128_t {
+        return this->fetch_add(arg) + arg;
+    }
+
+    auto operator-=(uint128_t const arg) noexcept -> uint128_t {
+        return this->fetch_sub(arg) - arg;
+    }
+
+    auto operator&=(uint128_t const arg) noexcept -> uint128_t {
+        return this->fetch_and(arg) & arg;
+    }
+
+    auto operator|=(uint128_t const arg) noexcept -> uint128_t {
+        return this->fetch_or(arg) | arg;
+    }
+
+    auto operator^=(uint128_t const arg) noexcept -> uint128_t {
+        return this->fetch_xor(arg) ^ arg;
+    }
+
+    auto operator++() noexcept -> uint128_t {
+        return this->fetch_add(1) + 1;
+    }
+
+    auto operator--() noexcept -> uint128_t {
+        return this->fetch_sub(1) - 1;
+    }
+
+    auto operator++(int) noexcept -> uint128_t {
+        return this->fetch_add(1);
+    }
+
+    auto operator--(int) noexcept -> uint128_t {
+        return this->fetch_sub(1);
+    }
+
+private:
+    // Replaces the value with f(value) in a compare-and-swap loop, returns the previous value.
+    // A failed compare-and-swap hands back the current value, so the loop does not reload.
+    template <typename F>
+    auto update(F const f) noexcept -> uint128_t {
+        std::uint64_t expected[2];
+        uint128::details::load_words_relaxed(this->words_, expected);
+        for (;;) {
+            uint128_t const value{ expected[1], expected[0] };
+            uint128_t const desired = f(value);
+            std::uint64_t const desired_words[2]{ desired.lower(), desired.upper() };
+            if (uint128::details::cas128(this->words_, expected, desired_words)) {
+                return value;
+            }
+        }
+    }
+
+    // lower word first, independent of the byte order of uint128_t
+    alignas(16) mutable std::uint64_t words_[2]{};
+};
+
+static_assert(sizeof(atomic_uint128) == 16 && alignof(atomic_uint128) == 16);
+
+#endif
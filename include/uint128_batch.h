@@ -0,0 +1,551 @@
+// Copyright(c) 2023 - present, Payton Wu (payton.wu@outlook.com) & the contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+// Bulk operations over contiguous ranges of uint128_t.
+
+#if !defined(UINT128_BATCH_H)
+#define UINT128_BATCH_H  // NOLINT(clang-diagnostic-unused-macros)
+#pragma once
+
+#include "uint128.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#   include <emmintrin.h>
+#endif
+
+// Kernels compiled for newer instruction sets with target attributes and picked at runtime.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#   define UINT128_BATCH_X86_DISPATCH 1
+#   include <immintrin.h>
+#endif
+
+struct parse_column_result {
+    std::size_t rows;    // number of values written, including rows that failed to parse
+    std::size_t errors;  // number of rows flagged in the error bitmap
+    char const * ptr;    // start of the first row that was not parsed, or the end of the text
+};
+
+namespace uint128::details {
+
+// Bit i is set where block[i] == c, for a block of 64 characters.
+inline auto match_mask64(char const * const block, char const c) noexcept -> std::uint64_t {
+#if defined(__SSE2__) || defined(_M_X64)
+    __m128i const needle = _mm_set1_epi8(c);
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        __m128i const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(block + 16 * i));
+        mask |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)))) << (16 * i);
+    }
+    return mask;
+#else
+    // written so that compilers vectorize it (e.g. NEON compare + narrowing)
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 64; ++i) {
+        mask |= static_cast<std::uint64_t>(block[i] == c) << i;
+    }
+    return mask;
+#endif
+}
+
+// Calls emit(token_first, token_last) for every `delimiter`-separated token of [first, last).
+// A delimiter at the very end does not start another token. Stops early when emit returns false.
+// Returns the start of the first token that was not consumed, or `last`.
+template <typename Emit>
+auto for_each_token(char const * const first, char const * const last, char const delimiter, Emit && emit) -> char const * {
+    char const * token = first;
+    char const * block = first;
+
+    // delimiter positions are found 64 characters at a time, then visited bit by bit
+    while (last - block >= 64) {
+        std::uint64_t mask = match_mask64(block, delimiter);
+        while (mask) {
+            char const * const end = block + std::countr_zero(mask);
+            if (!emit(token, end)) {
+                return token;
+            }
+            token = end + 1;
+            mask &= mask - 1;
+        }
+        block += 64;
+    }
+
+    for (; block != last; ++block) {
+        if (*block == delimiter) {
+            if (!emit(token, block)) {
+                return token;
+            }
+            token = block + 1;
+        }
+    }
+
+    if (token != last) {
+        if (!emit(token, last)) {
+            return token;
+        }
+    }
+    return last;
+}
+
+// Parses one whole token from fixed 8-character blocks, so short and long tokens take the
+// same few word-wide steps instead of a character loop. The leading full blocks are loaded
+// at `first`; the remaining 1..7 characters are loaded as the 8 characters ending at `last`,
+// with the bytes before the token replaced by '0'.
+// Precondition: last - 8 does not point before the start of the text.
+// fold(value, count) appends the value of `count` digits and returns false on overflow.
+template <typename Valid, typename Parse, typename Fold>
+auto parse_token_blocks(char const * const first, char const * const last, Valid valid, Parse parse, Fold fold) noexcept -> bool {
+    auto const len = static_cast<std::size_t>(last - first);
+    bool ok = len != 0;
+
+    char const * p = first;
+    for (std::size_t i = 0; i < len / 8; ++i, p += 8) {
+        std::uint64_t const chars = load_chars_le(p);
+        ok &= valid(chars);
+        ok &= fold(parse(chars), 8);
+    }
+
+    if (auto const rest = static_cast<unsigned>(len % 8)) {
+        std::uint64_t const padding = ~std::uint64_t{ 0 } >> (8 * rest);
+        std::uint64_t const chars = (load_chars_le(last - 8) & ~padding) | (0x3030303030303030 & padding);
+        ok &= valid(chars);
+        ok &= fold(parse(chars), rest);
+    }
+    return ok;
+}
+
+// Parses one whole token. Returns false if the token is empty, has a character that is
+// not a digit of `base`, or does not fit in 128 bits.
+// `text_first` is the start of the text, used to know whether the token can be read in blocks.
+inline auto parse_token(char const * const text_first, char const * const first, char const * const last, int const base, uint128_t & value) noexcept -> bool {
+    std::uint64_t upper{};
+    std::uint64_t lower{};
+    bool ok = false;
+    bool const blocks = last - text_first >= 8;
+
+    if (base == 10 && blocks && last - first <= 40) {
+        constexpr std::uint64_t pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+        ok = parse_token_blocks(first, last, is_eight_decimal_digits, parse_eight_decimal_digits, [&](std::uint64_t const digits, unsigned const count) {
+            return !mul_add_overflow(upper, lower, pow10[count], digits);
+        });
+    } else if (base == 16 && blocks && last - first <= 40) {
+        ok = parse_token_blocks(first, last, [](std::uint64_t const chars) { return hex_digit_mask(chars) == 0x8080808080808080; }, parse_eight_hex_digits, [&](std::uint64_t const digits, unsigned const count) {
+            auto const bits = 4 * count;
+            bool const fits = (upper >> (64 - bits)) == 0;
+            upper = (upper << bits) | (lower >> (64 - bits));
+            lower = (lower << bits) | digits;
+            return fits;
+        });
+    } else if (base == 10 || base == 16) {
+        auto const res = base == 10 ? parse_decimal(first, last, upper, lower) : parse_hex(first, last, upper, lower);
+        ok = first != last && res.ptr == last && !res.overflow;
+    } else {
+        auto const [ptr, ec] = from_chars(first, last, value, base);
+        return ec == std::errc{} && ptr == last;
+    }
+
+    value = uint128_t{ upper, lower };
+    return ok;
+}
+
+template <typename Out>
+auto parse_column(std::string_view const text, char const delimiter, Out out, std::span<std::uint64_t> const error_bitmap, int const base, std::size_t const max_rows) -> parse_column_result {
+    assert(2 <= base && base <= 36);
+    assert(max_rows <= error_bitmap.size() * 64);
+
+    std::size_t rows = 0;
+    std::size_t errors = 0;
+
+    char const * const text_first = text.data();
+    char const * const stop = for_each_token(text_first, text_first + text.size(), delimiter, [&](char const * const first, char const * last) {
+        if (rows == max_rows) {
+            return false;
+        }
+
+        if (delimiter == '\n' && last != first && last[-1] == '\r') {
+            --last;
+        }
+
+        uint128_t value;
+        bool const ok = parse_token(text_first, first, last, base, value);
+
+        auto & word = error_bitmap[rows / 64];
+        if (rows % 64 == 0) {
+            word = 0;
+        }
+        if (!ok) {
+            word |= std::uint64_t{ 1 } << (rows % 64);
+            value = 0;
+            ++errors;
+        }
+
+        *out = value;
+        ++out;
+        ++rows;
+        return true;
+    });
+
+    return { rows, errors, stop };
+}
+
+// Reverses the 16 bytes of each of the `count` elements of `in` into `out` (which may be `in`).
+inline void byteswap128_scalar(std::byte const * const in, std::byte * const out, std::size_t const count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t words[2];
+        std::memcpy(words, in + 16 * i, 16);
+        std::uint64_t const swapped[2] = { byteswap64(words[1]), byteswap64(words[0]) };
+        std::memcpy(out + 16 * i, swapped, 16);
+    }
+}
+
+#if defined(UINT128_BATCH_X86_DISPATCH)
+// A byte shuffle per element; 256 and 512-bit shuffles reverse within each 128-bit lane,
+// which is exactly one element per lane.
+__attribute__((target("ssse3"))) inline void byteswap128_ssse3(std::byte const * const in, std::byte * const out, std::size_t const count) noexcept {
+    __m128i const reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        __m128i const value = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + 16 * i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16 * i), _mm_shuffle_epi8(value, reverse));
+    }
+}
+
+__attribute__((target("avx2"))) inline void byteswap128_avx2(std::byte const * const in, std::byte * const out, std::size_t const count) noexcept {
+    __m256i const reverse = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                             15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i const first = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + 16 * i));
+        __m256i const second = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + 16 * i + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 16 * i), _mm256_shuffle_epi8(first, reverse));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 16 * i + 32), _mm256_shuffle_epi8(second, reverse));
+    }
+    for (; i < count; ++i) {
+        __m128i const value = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + 16 * i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16 * i), _mm_shuffle_epi8(value, _mm256_castsi256_si128(reverse)));
+    }
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void byteswap128_avx512(std::byte const * const in, std::byte * const out, std::size_t const count) noexcept {
+    // the byte order reversed in each 16-byte lane, built without _mm512_broadcast_i32x4
+    // whose undefined source upsets GCC 12's -Wuninitialized
+    __m512i const reverse = _mm512_set_epi64(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL, 0x0001020304050607LL, 0x08090a0b0c0d0e0fLL,
+                                             0x0001020304050607LL, 0x08090a0b0c0d0e0fLL, 0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m512i const value = _mm512_loadu_si512(in + 16 * i);
+        _mm512_storeu_si512(out + 16 * i, _mm512_shuffle_epi8(value, reverse));
+    }
+    if (i < count) {
+        // 1 to 3 elements left: a masked load and store of 16 to 48 bytes
+        __mmask64 const mask = ~std::uint64_t{ 0 } >> (64 - 16 * (count - i));
+        __m512i const value = _mm512_maskz_loadu_epi8(mask, in + 16 * i);
+        _mm512_mask_storeu_epi8(out + 16 * i, mask, _mm512_shuffle_epi8(value, reverse));
+    }
+}
+#endif
+
+using byteswap128_kernel = void (*)(std::byte const *, std::byte *, std::size_t) noexcept;
+
+// The widest kernel the running CPU supports.
+inline auto select_byteswap128() noexcept -> byteswap128_kernel {
+#if defined(UINT128_BATCH_X86_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) {
+        return byteswap128_avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return byteswap128_avx2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return byteswap128_ssse3;
+    }
+#endif
+    return byteswap128_scalar;
+}
+
+// Converts `count` 16-byte elements between host order and big-endian (network) order.
+inline void convert_big_endian128(std::byte const * const in, std::byte * const out, std::size_t const count) noexcept {
+    if constexpr (std::endian::native == std::endian::big) {
+        if (in != out) {
+            std::memmove(out, in, 16 * count);
+        }
+    } else {
+        static byteswap128_kernel const kernel = select_byteswap128();
+        kernel(in, out, count);
+    }
+}
+
+}
+
+// Parses `delimiter`-separated numbers in `base` from `text` into `out` without allocating.
+//
+// Row i that is empty, contains a character other than a digit or does not fit in 128 bits
+// is stored as 0 and flagged by bit (i % 64) of error_bitmap[i / 64]; the bitmap words are
+// cleared as rows are written. With '\n' as delimiter a trailing '\r' of each row is ignored.
+// Parsing stops when the bitmap is full; `ptr` then points at the next row.
+template <std::output_iterator<uint128_t> Out>
+auto parse_column(std::string_view const text, char const delimiter, Out out, std::span<std::uint64_t> const error_bitmap, int const base = 10) -> parse_column_result {
+    return uint128::details::parse_column(text, delimiter, out, error_bitmap, base, error_bitmap.size() * 64);
+}
+
+// As above, and also stops when `out` is full.
+template <std::size_t Extent>
+auto parse_column(std::string_view const text, char const delimiter, std::span<uint128_t, Extent> const out, std::span<std::uint64_t> const error_bitmap, int const base = 10) -> parse_column_result {
+    return uint128::details::parse_column(text, delimiter, out.begin(), error_bitmap, base, std::min(out.size(), error_bitmap.size() * 64));
+}
+
+// Bulk conversion between host order uint128_t values and big-endian (network order)
+// 16-byte records, e.g. IPv6 addresses or UUIDs on the wire. Element i of the byte form is
+// values[i].to_bytes(); each call dispatches once to the widest byte shuffle the CPU supports
+// (SSSE3, AVX2 or AVX-512BW on x86-64, scalar byte swaps elsewhere).
+
+// Writes values.size() records to `out`, which must hold 16 * values.size() bytes.
+inline void hton(std::span<uint128_t const> const values, std::span<std::byte> const out) noexcept {
+    assert(out.size() >= 16 * values.size());
+    uint128::details::convert_big_endian128(reinterpret_cast<std::byte const *>(values.data()), out.data(), values.size());
+}
+
+// Reads values.size() records from `in`, which must hold 16 * values.size() bytes.
+inline void ntoh(std::span<std::byte const> const in, std::span<uint128_t> const values) noexcept {
+    assert(in.size() >= 16 * values.size());
+    uint128::details::convert_big_endian128(in.data(), reinterpret_cast<std::byte *>(values.data()), values.size());
+}
+
+// In place: afterwards the bytes of `values` are the network order records (hton), or the
+// elements hold the values of the records that were stored in them (ntoh).
+inline void hton(std::span<uint128_t> const values) noexcept {
+    auto * const bytes = reinterpret_cast<std::byte *>(values.data());
+    uint128::details::convert_big_endian128(bytes, bytes, values.size());
+}
+
+inline void ntoh(std::span<uint128_t> const values) noexcept {
+    hton(values);
+}
+
+// Writes every value of `values` as 32 hexadecimal digits followed by `delimiter` into
+// one contiguous buffer, without allocating. Each value takes exactly 33 characters.
+// Returns { out.data(), std::errc::value_too_large } and writes nothing if `out` is too small.
+inline auto format_hex_column(std::span<uint128_t const> const values, std::span<char> const out, char const delimiter = '\n', bool const uppercase = false) -> std::to_chars_result {
+    if (out.size() / 33 < values.size()) {
+        return { out.data(), std::errc::value_too_large };
+    }
+
+    char * p = out.data();
+    for (auto const & value : values) {
+        uint128::details::write_hex32(p, value.upper(), value.lower(), uppercase);
+        p[32] = delimiter;
+        p += 33;
+    }
+    return { p, std::errc{} };
+}
+
+namespace uint128::details {
+
+// Recursive block swap on the 64-bit words of the rows: swap the upper right and lower left
+// 64 x 64 blocks (whole words), then the 32 x 32 blocks inside each 64 x 64 block with shifts
+// and masks, and so on down to single bits.
+inline void transpose128_scalar(uint128_t const * const in, uint128_t * const out) noexcept {
+    std::uint64_t lower[128];
+    std::uint64_t upper[128];
+    for (std::size_t i = 0; i < 128; ++i) {
+        lower[i] = in[i].lower();
+        upper[i] = in[i].upper();
+    }
+
+    for (std::size_t k = 0; k < 64; ++k) {
+        std::uint64_t const t = upper[k];
+        upper[k] = lower[k + 64];
+        lower[k + 64] = t;
+    }
+
+    std::uint64_t mask = 0x00000000ffffffffULL;
+    for (std::size_t j = 32; j; j >>= 1, mask ^= mask << j) {
+        // rows k with bit j clear swap their upper j columns of each 2j block with the lower
+        // j columns of row k + j
+        for (std::size_t k = 0; k < 128; k = (k + j + 1) & ~j) {
+            std::uint64_t const t_lower = ((lower[k] >> j) ^ lower[k + j]) & mask;
+            lower[k + j] ^= t_lower;
+            lower[k] ^= t_lower << j;
+            std::uint64_t const t_upper = ((upper[k] >> j) ^ upper[k + j]) & mask;
+            upper[k + j] ^= t_upper;
+            upper[k] ^= t_upper << j;
+        }
+    }
+
+    for (std::size_t i = 0; i < 128; ++i) {
+        out[i] = { upper[i], lower[i] };
+    }
+}
+
+#if defined(__SSE2__) || defined(_M_X64)
+// 16 rows at a time: a 16 x 16 byte transpose (four rounds of interleaving row i with row
+// i + 8, each moving one bit of the row index into the column index) puts byte c of the
+// 16 rows in one vector, and 8 movemasks shifting it left by one bit each give 16 bits of
+// output rows 8c + 7 down to 8c.
+inline void transpose128_sse2(uint128_t const * const in, uint128_t * const out) noexcept {
+    // planes[row][group] are bits 16 * group to 16 * group + 15 of an output row
+    std::uint16_t planes[128][8];
+    for (std::size_t group = 0; group < 8; ++group) {
+        __m128i rows[16];
+        for (std::size_t r = 0; r < 16; ++r) {
+            rows[r] = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + 16 * group + r));
+        }
+        for (int round = 0; round < 4; ++round) {
+            __m128i interleaved[16];
+            for (std::size_t i = 0; i < 8; ++i) {
+                interleaved[2 * i] = _mm_unpacklo_epi8(rows[i], rows[i + 8]);
+                interleaved[2 * i + 1] = _mm_unpackhi_epi8(rows[i], rows[i + 8]);
+            }
+            std::memcpy(rows, interleaved, sizeof(rows));
+        }
+        for (std::size_t c = 0; c < 16; ++c) {
+            __m128i column = rows[c];
+            for (std::size_t b = 8; b-- > 0;) {
+                planes[8 * c + b][group] = static_cast<std::uint16_t>(_mm_movemask_epi8(column));
+                column = _mm_add_epi8(column, column);
+            }
+        }
+    }
+    std::memcpy(out, planes, sizeof(planes));
+}
+#endif
+
+#if defined(UINT128_BATCH_X86_DISPATCH)
+// The SSE2 kernel on two groups of 16 rows at once, one per 128-bit lane.
+__attribute__((target("avx2"))) inline void transpose128_avx2(uint128_t const * const in, uint128_t * const out) noexcept {
+    std::uint32_t planes[128][4];
+    for (std::size_t pair = 0; pair < 4; ++pair) {
+        __m256i rows[16];
+        for (std::size_t r = 0; r < 16; ++r) {
+            __m128i const first = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + 32 * pair + r));
+            __m128i const second = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + 32 * pair + 16 + r));
+            rows[r] = _mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1);
+        }
+        for (int round = 0; round < 4; ++round) {
+            __m256i interleaved[16];
+            for (std::size_t i = 0; i < 8; ++i) {
+                interleaved[2 * i] = _mm256_unpacklo_epi8(rows[i], rows[i + 8]);
+                interleaved[2 * i + 1] = _mm256_unpackhi_epi8(rows[i], rows[i + 8]);
+            }
+            std::memcpy(rows, interleaved, sizeof(rows));
+        }
+        for (std::size_t c = 0; c < 16; ++c) {
+            __m256i column = rows[c];
+            for (std::size_t b = 8; b-- > 0;) {
+                planes[8 * c + b][pair] = static_cast<std::uint32_t>(_mm256_movemask_epi8(column));
+                column = _mm256_add_epi8(column, column);
+            }
+        }
+    }
+    std::memcpy(out, planes, sizeof(planes));
+}
+
+// Byte permutations of transpose128_gfni.
+struct transpose128_gfni_indices {
+    std::uint8_t gather[2][64];
+    std::uint8_t split[2][64];
+    std::uint8_t output[2][64];
+};
+
+constexpr auto make_transpose128_gfni_indices() noexcept -> transpose128_gfni_indices {
+    transpose128_gfni_indices indices{};
+    for (unsigned s = 0; s < 2; ++s) {
+        for (unsigned n = 0; n < 64; ++n) {
+            // byte n / 8 of rows 7 down to 0 of a pair of vectors holding 8 rows
+            indices.gather[s][n] = static_cast<std::uint8_t>((7 - n % 8) * 16 + 8 * s + n / 8);
+            // columns 4s to 4s + 3 of the rows 0-7 and 8-15 gathered above, 16 bytes each
+            indices.split[s][n] = static_cast<std::uint8_t>((n % 16) / 8 * 64 + (4 * s + n / 16) * 8 + n % 8);
+            // byte b of the 16 tiles of a column becomes output row 8c + b, b = 4s + n / 16
+            indices.output[s][n] = static_cast<std::uint8_t>((n % 16) * 8 + 4 * s + n / 16);
+        }
+    }
+    return indices;
+}
+
+inline constexpr transpose128_gfni_indices transpose128_gfni_index = make_transpose128_gfni_indices();
+
+// 8 x 8 bit tiles: byte c of rows 8t to 8t + 7 (last row first) is tile (t, c), and
+// gf2p8affineqb with the tile as the matrix and bytes 1 << j as the data transposes it, so
+// that byte b of the result is byte t of output row 8c + b. Byte permutations arrange the
+// tiles of each group of 16 rows by column into a buffer, then the 16 tiles of each column
+// into output rows.
+__attribute__((target("avx512f,avx512bw,avx512vbmi,gfni"))) inline void transpose128_gfni(uint128_t const * const in, uint128_t * const out) noexcept {
+    auto const & index = transpose128_gfni_index;
+    __m512i const gather[2] = { _mm512_loadu_si512(index.gather[0]), _mm512_loadu_si512(index.gather[1]) };
+    __m512i const split[2] = { _mm512_loadu_si512(index.split[0]), _mm512_loadu_si512(index.split[1]) };
+    __m512i const bits = _mm512_set1_epi64(0x8040201008040201LL);
+
+    // tiles[group][column]: the two transposed tiles of one column of 16 rows
+    alignas(64) std::uint8_t tiles[8][16][16];
+    for (std::size_t group = 0; group < 8; ++group) {
+        __m512i rows[4];
+        for (std::size_t i = 0; i < 4; ++i) {
+            rows[i] = _mm512_loadu_si512(in + 16 * group + 4 * i);
+        }
+        __m512i const lower[2] = { _mm512_permutex2var_epi8(rows[0], gather[0], rows[1]), _mm512_permutex2var_epi8(rows[0], gather[1], rows[1]) };
+        __m512i const upper[2] = { _mm512_permutex2var_epi8(rows[2], gather[0], rows[3]), _mm512_permutex2var_epi8(rows[2], gather[1], rows[3]) };
+        for (std::size_t j = 0; j < 4; ++j) {
+            __m512i const columns = _mm512_permutex2var_epi8(lower[j / 2], split[j % 2], upper[j / 2]);
+            _mm512_store_si512(tiles[group][4 * j], _mm512_gf2p8affine_epi64_epi8(bits, columns, 0));
+        }
+    }
+
+    __m512i const output[2] = { _mm512_loadu_si512(index.output[0]), _mm512_loadu_si512(index.output[1]) };
+    for (std::size_t c = 0; c < 16; ++c) {
+        __m512i halves[2];
+        for (std::size_t h = 0; h < 2; ++h) {
+            __m512i v = _mm512_castsi128_si512(_mm_load_si128(reinterpret_cast<__m128i const *>(tiles[4 * h][c])));
+            v = _mm512_inserti32x4(v, _mm_load_si128(reinterpret_cast<__m128i const *>(tiles[4 * h + 1][c])), 1);
+            v = _mm512_inserti32x4(v, _mm_load_si128(reinterpret_cast<__m128i const *>(tiles[4 * h + 2][c])), 2);
+            halves[h] = _mm512_inserti32x4(v, _mm_load_si128(reinterpret_cast<__m128i const *>(tiles[4 * h + 3][c])), 3);
+        }
+        _mm512_storeu_si512(out + 8 * c, _mm512_permutex2var_epi8(halves[0], output[0], halves[1]));
+        _mm512_storeu_si512(out + 8 * c + 4, _mm512_permutex2var_epi8(halves[0], output[1], halves[1]));
+    }
+}
+#endif
+
+// Kernels read all of `in` before writing `out`, or work on a copy, so `in` may be `out`.
+using transpose128_kernel = void (*)(uint128_t const *, uint128_t *) noexcept;
+
+// The widest kernel the running CPU supports.
+inline auto select_transpose128() noexcept -> transpose128_kernel {
+#if defined(UINT128_BATCH_X86_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("gfni")) {
+        return transpose128_gfni;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return transpose128_avx2;
+    }
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+    return transpose128_sse2;
+#else
+    return transpose128_scalar;
+#endif
+}
+
+}
+
+// Transposes a 128 x 128 bit matrix stored as 128 rows: bit j of in[i] becomes bit i of
+// out[j], e.g. 128 records into 128 bit planes for bit-sliced processing. `in` and `out`
+// may be the same matrix. Dispatches once to AVX-512 GFNI, AVX2 or SSE2 on x86-64 and to a
+// recursive block swap on 64-bit words elsewhere.
+inline void transpose(std::span<uint128_t const, 128> const in, std::span<uint128_t, 128> const out) noexcept {
+    static uint128::details::transpose128_kernel const kernel = uint128::details::select_transpose128();
+    kernel(in.data(), out.data());
+}
+
+inline void transpose(std::span<uint128_t, 128> const matrix) noexcept {
+    transpose(matrix, matrix);
+}
+
+#endif
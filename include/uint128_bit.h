@@ -0,0 +1,194 @@
+// Copyright(c) 2023 - present, Payton Wu (payton.wu@outlook.com) & the contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+// <bit>-style operations on uint128_t.
+//
+//   rotl(x, s) / rotr(x, s)            like std::rotl / std::rotr: s is taken modulo 128 and
+//                                      negative counts rotate the other way.
+//   funnel_shift_left(hi, lo, n)       upper half of the 256-bit hi:lo shifted left by n % 128.
+//   funnel_shift_right(hi, lo, n)      lower half of the 256-bit hi:lo shifted right by n % 128.
+//   shl<N>(x) / shr<N>(x)              shifts by a compile-time count: three shifts and an or,
+//                                      or one word move, with no count checks.
+//
+// The shifts and rotates are branchless: counts select words with conditional moves instead
+// of comparing against 0 and 64.
+//
+//   popcount, countl_zero, countr_zero, countl_one, countr_one, bit_width, has_single_bit,
+//   bit_floor, bit_ceil, byteswap      like their <bit> namesakes, one instruction per half
+//                                      (popcnt, lzcnt, tzcnt, bswap with the matching -m flags).
+//                                      bit_ceil returns 0 when the result does not fit.
+//   bit_reverse(x)                     bit 0 becomes bit 127.
+//   rank(x, i)                         number of set bits below bit i, i in [0, 128].
+//   select(x, k)                       position of the k-th set bit counting from 0, or 128 if
+//                                      x has k bits or fewer. pdep + tzcnt when compiled with
+//                                      BMI2 (slow on AMD before Zen 3), a broadword byte search
+//                                      otherwise.
+
+#if !defined(UINT128_BIT_H)
+#define UINT128_BIT_H  // NOLINT(clang-diagnostic-unused-macros)
+#pragma once
+
+#include "uint128.h"
+
+#include <bit>
+#include <cstdint>
+
+#if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+#   include <immintrin.h>
+#endif
+
+namespace uint128::details {
+
+// Reverses the bits of a 64-bit word.
+constexpr auto bit_reverse64(std::uint64_t value) noexcept -> std::uint64_t {
+#if defined(__has_builtin)
+#   if __has_builtin(__builtin_bitreverse64)
+    return __builtin_bitreverse64(value);
+#   endif
+#endif
+    // swap bits, pairs and nibbles within each byte, then reverse the bytes
+    value = ((value >> 1) & 0x5555555555555555ULL) | ((value & 0x5555555555555555ULL) << 1);
+    value = ((value >> 2) & 0x3333333333333333ULL) | ((value & 0x3333333333333333ULL) << 2);
+    value = ((value >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((value & 0x0f0f0f0f0f0f0f0fULL) << 4);
+    return byteswap64(value);
+}
+
+// Position of the k-th set bit of `word` counting from 0, or 64 if it has k bits or fewer.
+constexpr auto select64(std::uint64_t const word, unsigned const k) noexcept -> unsigned {
+#if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+    if (!std::is_constant_evaluated()) {
+        return k < 64 ? static_cast<unsigned>(std::countr_zero(_pdep_u64(std::uint64_t{ 1 } << k, word))) : 64;
+    }
+#endif
+
+    if (k >= static_cast<unsigned>(std::popcount(word))) {
+        return 64;
+    }
+
+    // byte i of `prefix`: set bits in bytes 0..i
+    constexpr std::uint64_t ones = 0x0101010101010101ULL;
+    constexpr std::uint64_t highs = 0x8080808080808080ULL;
+    std::uint64_t counts = word - ((word >> 1) & 0x5555555555555555ULL);
+    counts = (counts & 0x3333333333333333ULL) + ((counts >> 2) & 0x3333333333333333ULL);
+    std::uint64_t const prefix = ((counts + (counts >> 4)) & 0x0f0f0f0f0f0f0f0fULL) * ones;
+
+    // the high bit of byte i survives (k + 128) - prefix_i exactly when prefix_i <= k,
+    // and the number of such bytes is the byte holding the k-th bit
+    auto const byte = static_cast<unsigned>(std::popcount((((k * ones) | highs) - prefix) & highs));
+    unsigned rest = k - static_cast<unsigned>(((prefix << 8) >> (8 * byte)) & 0xff);
+
+    auto bits = static_cast<std::uint8_t>(word >> (8 * byte));
+    for (; rest; --rest) {
+        bits &= static_cast<std::uint8_t>(bits - 1);
+    }
+    return 8 * byte + static_cast<unsigned>(std::countr_zero(bits));
+}
+
+}
+
+[[nodiscard]] constexpr auto rotl(uint128_t const value, int const count) noexcept -> uint128_t {
+    std::uint64_t upper{};
+    std::uint64_t const lower = uint128::details::rotl128(value.upper(), value.lower(), static_cast<unsigned>(count) & 127u, upper);
+    return { upper, lower };
+}
+
+[[nodiscard]] constexpr auto rotr(uint128_t const value, int const count) noexcept -> uint128_t {
+    // rotating right by s is rotating left by 128 - s, computed in unsigned so INT_MIN is fine
+    std::uint64_t upper{};
+    std::uint64_t const lower = uint128::details::rotl128(value.upper(), value.lower(), (0u - static_cast<unsigned>(count)) & 127u, upper);
+    return { upper, lower };
+}
+
+[[nodiscard]] constexpr auto funnel_shift_left(uint128_t const hi, uint128_t const lo, unsigned const count) noexcept -> uint128_t {
+    // (lo >> 1) >> (127 - n) is lo >> (128 - n) without a count of 128
+    unsigned const n = count & 127u;
+    return (hi << n) | ((lo >> 1u) >> (127u - n));
+}
+
+[[nodiscard]] constexpr auto funnel_shift_right(uint128_t const hi, uint128_t const lo, unsigned const count) noexcept -> uint128_t {
+    unsigned const n = count & 127u;
+    return (lo >> n) | ((hi << 1u) << (127u - n));
+}
+
+template <unsigned N>
+    requires(N < 128)
+[[nodiscard]] constexpr auto shl(uint128_t const value) noexcept -> uint128_t {
+    if constexpr (N == 0) {
+        return value;
+    } else if constexpr (N < 64) {
+        return { (value.upper() << N) | (value.lower() >> (64 - N)), value.lower() << N };
+    } else {
+        return { value.lower() << (N - 64), 0u };
+    }
+}
+
+template <unsigned N>
+    requires(N < 128)
+[[nodiscard]] constexpr auto shr(uint128_t const value) noexcept -> uint128_t {
+    if constexpr (N == 0) {
+        return value;
+    } else if constexpr (N < 64) {
+        return { value.upper() >> N, (value.lower() >> N) | (value.upper() << (64 - N)) };
+    } else {
+        return { 0u, value.upper() >> (N - 64) };
+    }
+}
+
+[[nodiscard]] constexpr auto popcount(uint128_t const value) noexcept -> int {
+    return std::popcount(value.upper()) + std::popcount(value.lower());
+}
+
+[[nodiscard]] constexpr auto countl_zero(uint128_t const value) noexcept -> int {
+    return value.upper() ? std::countl_zero(value.upper()) : 64 + std::countl_zero(value.lower());
+}
+
+[[nodiscard]] constexpr auto countr_zero(uint128_t const value) noexcept -> int {
+    return value.lower() ? std::countr_zero(value.lower()) : 64 + std::countr_zero(value.upper());
+}
+
+[[nodiscard]] constexpr auto countl_one(uint128_t const value) noexcept -> int {
+    return countl_zero(~value);
+}
+
+[[nodiscard]] constexpr auto countr_one(uint128_t const value) noexcept -> int {
+    return countr_zero(~value);
+}
+
+[[nodiscard]] constexpr auto bit_width(uint128_t const value) noexcept -> int {
+    return 128 - countl_zero(value);
+}
+
+[[nodiscard]] constexpr auto has_single_bit(uint128_t const value) noexcept -> bool {
+    return popcount(value) == 1;
+}
+
+[[nodiscard]] constexpr auto bit_floor(uint128_t const value) noexcept -> uint128_t {
+    return value ? uint128_1 << (bit_width(value) - 1) : uint128_0;
+}
+
+// 0 above 2^127, where std::bit_ceil would be undefined.
+[[nodiscard]] constexpr auto bit_ceil(uint128_t const value) noexcept -> uint128_t {
+    return value <= 1 ? uint128_1 : uint128_1 << bit_width(value - 1);
+}
+
+[[nodiscard]] constexpr auto byteswap(uint128_t const value) noexcept -> uint128_t {
+    return { uint128::details::byteswap64(value.lower()), uint128::details::byteswap64(value.upper()) };
+}
+
+[[nodiscard]] constexpr auto bit_reverse(uint128_t const value) noexcept -> uint128_t {
+    return { uint128::details::bit_reverse64(value.lower()), uint128::details::bit_reverse64(value.upper()) };
+}
+
+[[nodiscard]] constexpr auto rank(uint128_t const value, unsigned const index) noexcept -> int {
+    return popcount(value & ~(~uint128_0 << index));
+}
+
+[[nodiscard]] constexpr auto select(uint128_t const value, unsigned const k) noexcept -> int {
+    auto const lower_count = static_cast<unsigned>(std::popcount(value.lower()));
+    if (k < lower_count) {
+        return static_cast<int>(uint128::details::select64(value.lower(), k));
+    }
+    return 64 + static_cast<int>(uint128::details::select64(value.upper(), k - lower_count));
+}
+
+#endif
@@ -0,0 +1,345 @@
+// Copyright(c) 2023 - present, Payton Wu (payton.wu@outlook.com) & the contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+// Variable-length binary encodings of uint128_t over caller-provided buffers.
+//
+// LEB128:  unsigned LEB128, 7 bits per byte, least significant group first, the high bit
+//          of every byte but the last set. 1 byte below 2^7, at most 19 bytes.
+// compact: one length byte n in [0, 16] followed by the n significant bytes of the value,
+//          least significant first. 1 byte for 0, at most 17 bytes.
+//
+// Both follow the std::to_chars / std::from_chars conventions: encoders return
+// { ptr, std::errc::value_too_large } when the output is too small, decoders leave `value`
+// unmodified on error. Encoding and decoding work on whole 8-byte words.
+
+#if !defined(UINT128_CODEC_H)
+#define UINT128_CODEC_H  // NOLINT(clang-diagnostic-unused-macros)
+#pragma once
+
+#include "uint128.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+inline constexpr std::size_t leb128_max_size = 19;
+inline constexpr std::size_t compact_max_size = 17;
+
+struct encode_result {
+    std::byte * ptr;
+    std::errc ec;
+};
+
+struct decode_result {
+    std::byte const * ptr;
+    std::errc ec;
+};
+
+struct encode_batch_result {
+    std::size_t count;  // number of values encoded
+    std::byte * ptr;    // end of the last value encoded
+    std::errc ec;       // value_too_large if `out` filled up before every value was encoded
+};
+
+struct decode_batch_result {
+    std::size_t count;        // number of values decoded
+    std::byte const * ptr;    // end of the last value decoded
+    std::errc ec;             // error of the value at `ptr`, if any
+};
+
+namespace uint128::details {
+
+// Loads 8 bytes, p[0] into the least significant byte.
+constexpr auto load_bytes_le(std::byte const * const p) noexcept -> std::uint64_t {
+    if (!std::is_constant_evaluated()) {
+        std::uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        if constexpr (std::endian::native == std::endian::big) {
+            word = byteswap64(word);
+        }
+        return word;
+    }
+
+    std::uint64_t word = 0;
+    for (int i = 0; i < 8; ++i) {
+        word |= std::to_integer<std::uint64_t>(p[i]) << (8 * i);
+    }
+    return word;
+}
+
+// Stores 8 bytes, the least significant byte of `word` into p[0].
+constexpr void store_bytes_le(std::byte * const p, std::uint64_t word) noexcept {
+    if (!std::is_constant_evaluated()) {
+        if constexpr (std::endian::native == std::endian::big) {
+            word = byteswap64(word);
+        }
+        std::memcpy(p, &word, sizeof(word));
+        return;
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<std::byte>(word >> (8 * i));
+    }
+}
+
+// Loads min(size, 8) bytes at `p`, zero-filled.
+constexpr auto load_bytes_le(std::byte const * const p, std::size_t const size) noexcept -> std::uint64_t {
+    if (size >= 8) {
+        return load_bytes_le(p);
+    }
+
+    std::byte padded[8]{};
+    std::copy_n(p, size, padded);
+    return load_bytes_le(padded);
+}
+
+// The `bytes` lowest bytes of a word, bytes in [0, 8].
+constexpr auto low_bytes_mask(std::size_t const bytes) noexcept -> std::uint64_t {
+    return bytes >= 8 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << (8 * bytes)) - 1;
+}
+
+// Packs the low 7 bits of each byte into 56 bits (byte 0 lowest), the inverse of spread_7bit_groups.
+constexpr auto pack_7bit_groups(std::uint64_t x) noexcept -> std::uint64_t {
+    x &= 0x7f7f7f7f7f7f7f7f;
+    x = ((x & 0x7f007f007f007f00) >> 1) | (x & 0x007f007f007f007f);
+    x = ((x & 0x3fff00003fff0000) >> 2) | (x & 0x00003fff00003fff);
+    return ((x & 0x0fffffff00000000) >> 4) | (x & 0x000000000fffffff);
+}
+
+// Spreads 56 bits into the low 7 bits of each byte (byte 0 lowest).
+constexpr auto spread_7bit_groups(std::uint64_t x) noexcept -> std::uint64_t {
+    x = ((x & 0x00fffffff0000000) << 4) | (x & 0x000000000fffffff);
+    x = ((x & 0x0fffc0000fffc000) << 2) | (x & 0x00003fff00003fff);
+    return ((x & 0x3f803f803f803f80) << 1) | (x & 0x007f007f007f007f);
+}
+
+// LEB128 encoding of `value` in three words of 8 bytes; returns its length in bytes.
+constexpr auto leb128_words(uint128_t const value, std::uint64_t (&words)[3]) noexcept -> std::size_t {
+    std::size_t const size = std::max<std::size_t>((value.bits() + 6u) / 7u, 1);
+
+    words[0] = spread_7bit_groups(value.lower() & 0x00ffffffffffffff);
+    words[1] = spread_7bit_groups(((value.lower() >> 56) | (value.upper() << 8)) & 0x00ffffffffffffff);
+    words[2] = spread_7bit_groups(value.upper() >> 48);
+
+    // continuation bits on every byte before the last one
+    for (std::size_t i = 0; i < 3; ++i) {
+        std::size_t const before = std::min<std::size_t>(size - 1 - std::min(size - 1, 8 * i), 8);
+        words[i] |= 0x8080808080808080 & low_bytes_mask(before);
+    }
+    return size;
+}
+
+// Decodes one LEB128 value at `first`, reading whole words.
+constexpr auto leb128_decode(std::byte const * const first, std::byte const * const last, uint128_t & value) noexcept -> decode_result {
+    auto const available = static_cast<std::size_t>(last - first);
+
+    std::uint64_t groups[3]{};
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < 3 && !size; ++i) {
+        std::size_t const offset = std::min(8 * i, available);
+        std::uint64_t const word = load_bytes_le(first + offset, available - offset);
+        std::uint64_t const stops = ~word & 0x8080808080808080;
+        if (stops) {
+            std::size_t const bytes = static_cast<std::size_t>(std::countr_zero(stops)) / 8 + 1;
+            groups[i] = pack_7bit_groups(word & low_bytes_mask(bytes));
+            size = 8 * i + bytes;
+        } else {
+            groups[i] = pack_7bit_groups(word);
+        }
+    }
+
+    // bytes past the input read as 0, which ends the value
+    if (size > available) {
+        return { first, std::errc::invalid_argument };
+    }
+    if (!size) {
+        // no stop byte in 24 bytes: the value ends at the first one after them
+        std::byte const * end = first + 24;
+        while (end != last && (*end & std::byte{ 0x80 }) != std::byte{}) {
+            ++end;
+        }
+        if (end == last) {
+            return { first, std::errc::invalid_argument };
+        }
+        return { end + 1, std::errc::result_out_of_range };
+    }
+    if (size > leb128_max_size || groups[2] >> 16) {
+        return { first + size, std::errc::result_out_of_range };
+    }
+
+    value = uint128_t{ (groups[1] >> 8) | (groups[2] << 48), groups[0] | (groups[1] << 56) };
+    return { first + size, std::errc{} };
+}
+
+// Decodes one compact value at `first`, reading whole words.
+constexpr auto compact_decode(std::byte const * const first, std::byte const * const last, uint128_t & value) noexcept -> decode_result {
+    if (first == last) {
+        return { first, std::errc::invalid_argument };
+    }
+
+    auto const size = std::to_integer<std::size_t>(*first);
+    if (size > 16 || size >= static_cast<std::size_t>(last - first)) {
+        return { first, std::errc::invalid_argument };
+    }
+
+    std::byte const * const bytes = first + 1;
+    std::size_t const low_size = std::min<std::size_t>(size, 8);
+    if (last - bytes >= 16) {
+        value = uint128_t{ load_bytes_le(bytes + 8) & low_bytes_mask(size - low_size), load_bytes_le(bytes) & low_bytes_mask(low_size) };
+    } else {
+        value = uint128_t{ load_bytes_le(bytes + low_size, size - low_size), load_bytes_le(bytes, low_size) };
+    }
+    return { bytes + size, std::errc{} };
+}
+
+}
+
+// LEB128
+
+constexpr auto encode_leb128(std::byte * const first, std::byte * const last, uint128_t const value) noexcept -> encode_result {
+    // small counters take one byte
+    if (value < 0x80 && first != last) {
+        *first = static_cast<std::byte>(value.lower());
+        return { first + 1, std::errc{} };
+    }
+
+    std::uint64_t words[3];
+    auto const size = uint128::details::leb128_words(value, words);
+    if (static_cast<std::size_t>(last - first) < size) {
+        return { last, std::errc::value_too_large };
+    }
+
+    std::byte bytes[24];
+    for (std::size_t i = 0; i < 3; ++i) {
+        uint128::details::store_bytes_le(bytes + 8 * i, words[i]);
+    }
+    return { std::copy_n(bytes, size, first), std::errc{} };
+}
+
+// { first, std::errc::invalid_argument } if the input ends before the last byte,
+// { end of the value, std::errc::result_out_of_range } if it does not fit in 128 bits.
+constexpr auto decode_leb128(std::byte const * const first, std::byte const * const last, uint128_t & value) noexcept -> decode_result {
+    // values up to 8 bytes (56 bits) end within the first word
+    if (last - first >= 8) {
+        std::uint64_t const word = uint128::details::load_bytes_le(first);
+        if (std::uint64_t const stops = ~word & 0x8080808080808080) {
+            std::size_t const size = static_cast<std::size_t>(std::countr_zero(stops)) / 8 + 1;
+            value = uint128_t{ uint128::details::pack_7bit_groups(word & uint128::details::low_bytes_mask(size)) };
+            return { first + size, std::errc{} };
+        }
+    }
+
+    return uint128::details::leb128_decode(first, last, value);
+}
+
+// Compact
+
+constexpr auto encode_compact(std::byte * const first, std::byte * const last, uint128_t const value) noexcept -> encode_result {
+    auto const size = value.compact_size();
+    if (static_cast<std::size_t>(last - first) <= size) {
+        return { last, std::errc::value_too_large };
+    }
+
+    *first = static_cast<std::byte>(size);
+    auto const bytes = value.to_bytes(std::endian::little);
+    return { std::copy_n(bytes.begin(), size, first + 1), std::errc{} };
+}
+
+// { first, std::errc::invalid_argument } if the length byte is above 16 or the input ends early.
+constexpr auto decode_compact(std::byte const * const first, std::byte const * const last, uint128_t & value) noexcept -> decode_result {
+    return uint128::details::compact_decode(first, last, value);
+}
+
+// Batches: values are encoded back to back. Where at least one maximum-size encoding of
+// room is left, whole words are stored directly into `out` (bytes past the end of a value
+// are overwritten by the next one), so the per-value work is a few word operations.
+
+inline auto encode_leb128(std::span<uint128_t const> const values, std::span<std::byte> const out) noexcept -> encode_batch_result {
+    std::byte * p = out.data();
+    std::byte * const last = out.data() + out.size();
+    std::size_t count = 0;
+    for (; count < values.size(); ++count) {
+        auto const & value = values[count];
+        if (last - p >= 8 && !value.upper() && value.lower() >> 56 == 0) {
+            // up to 56 bits: one word
+            std::size_t const size = std::max<std::size_t>((std::bit_width(value.lower()) + 6) / 7, 1);
+            std::uint64_t const continuation = 0x8080808080808080 & uint128::details::low_bytes_mask(size - 1);
+            uint128::details::store_bytes_le(p, uint128::details::spread_7bit_groups(value.lower()) | continuation);
+            p += size;
+        } else if (last - p >= 24) {
+            std::uint64_t words[3];
+            auto const size = uint128::details::leb128_words(value, words);
+            uint128::details::store_bytes_le(p, words[0]);
+            uint128::details::store_bytes_le(p + 8, words[1]);
+            uint128::details::store_bytes_le(p + 16, words[2]);
+            p += size;
+        } else {
+            auto const [ptr, ec] = encode_leb128(p, last, values[count]);
+            if (ec != std::errc{}) {
+                return { count, p, ec };
+            }
+            p = ptr;
+        }
+    }
+    return { count, p, std::errc{} };
+}
+
+// Decodes until `values` is full or the input ends.
+inline auto decode_leb128(std::span<std::byte const> const in, std::span<uint128_t> const values) noexcept -> decode_batch_result {
+    std::byte const * p = in.data();
+    std::byte const * const last = in.data() + in.size();
+    std::size_t count = 0;
+    for (; count < values.size() && p != last; ++count) {
+        auto const [ptr, ec] = decode_leb128(p, last, values[count]);
+        if (ec != std::errc{}) {
+            return { count, p, ec };
+        }
+        p = ptr;
+    }
+    return { count, p, std::errc{} };
+}
+
+inline auto encode_compact(std::span<uint128_t const> const values, std::span<std::byte> const out) noexcept -> encode_batch_result {
+    std::byte * p = out.data();
+    std::byte * const last = out.data() + out.size();
+    std::size_t count = 0;
+    for (; count < values.size(); ++count) {
+        if (last - p >= 17) {
+            auto const & value = values[count];
+            auto const size = value.compact_size();
+            *p = static_cast<std::byte>(size);
+            uint128::details::store_bytes_le(p + 1, value.lower());
+            uint128::details::store_bytes_le(p + 9, value.upper());
+            p += 1 + size;
+        } else {
+            auto const [ptr, ec] = encode_compact(p, last, values[count]);
+            if (ec != std::errc{}) {
+                return { count, p, ec };
+            }
+            p = ptr;
+        }
+    }
+    return { count, p, std::errc{} };
+}
+
+// Decodes until `values` is full or the input ends.
+inline auto decode_compact(std::span<std::byte const> const in, std::span<uint128_t> const values) noexcept -> decode_batch_result {
+    std::byte const * p = in.data();
+    std::byte const * const last = in.data() + in.size();
+    std::size_t count = 0;
+    for (; count < values.size() && p != last; ++count) {
+        auto const [ptr, ec] = decode_compact(p, last, values[count]);
+        if (ec != std::errc{}) {
+            return { count, p, ec };
+        }
+        p = ptr;
+    }
+    return { count, p, std::errc{} };
+}
+
+#endif
@@ -0,0 +1,127 @@
+// Copyright(c) 2023 - present, Payton Wu (payton.wu@outlook.com) & the contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+// Striped 128-bit event / byte counter for many writers and occasional readers.
+//
+//   striped_uint128_counter bytes;
+//   bytes.add(size);                 // from any thread
+//   uint128_t const total = bytes.read();
+//
+// Each thread adds into one of a power-of-two number of 64-bit slots, each on its own cache
+// line, picked round-robin when the thread first touches a counter. add() is wait-free: one
+// relaxed fetch_add on the slot. The add that lifts a slot to 2^63 or above spills 2^63 into
+// a shared atomic_uint128 total, which happens once per 2^63 counted per slot. Adds of 2^56
+// or more go to the total directly, so a slot cannot wrap unless 128 adds race with a spill.
+//
+// read() sums the total and the slots with uint128_t::operator+=. A spill moves 2^63 from a
+// slot to the total, so readers retry when one overlapped the read (spills are counted when
+// they start and when they finish). The result is exact when no add is in flight, and
+// otherwise lies between the values at the start and the end of read().
+
+#if !defined(UINT128_COUNTER_H)
+#define UINT128_COUNTER_H  // NOLINT(clang-diagnostic-unused-macros)
+#pragma once
+
+#include "uint128.h"
+#include "uint128_atomic.h"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace uint128::details {
+
+struct alignas(64) counter_slot {
+    std::atomic<std::uint64_t> value{ 0 };
+};
+
+// Round-robin index of the calling thread, assigned on first use.
+inline auto this_thread_slot() noexcept -> std::size_t {
+    static std::atomic<std::size_t> next{ 0 };
+    thread_local std::size_t const index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+}
+
+class striped_uint128_counter {
+public:
+    // `slots` is rounded up to a power of two, one per hardware thread by default.
+    explicit striped_uint128_counter(std::size_t const slots = std::thread::hardware_concurrency())
+        : mask_(std::bit_ceil(slots ? slots : 1) - 1), slots_(std::make_unique<uint128::details::counter_slot[]>(mask_ + 1)) {
+    }
+
+    striped_uint128_counter(striped_uint128_counter const &) = delete;
+    auto operator=(striped_uint128_counter const &) -> striped_uint128_counter & = delete;
+
+    [[nodiscard]] auto slot_count() const noexcept -> std::size_t {
+        return this->mask_ + 1;
+    }
+
+    void add(std::uint64_t const n) noexcept {
+        if (n >= direct_threshold) {
+            static_cast<void>(this->total_.fetch_add(n));
+            return;
+        }
+
+        auto & slot = this->slots_[uint128::details::this_thread_slot() & this->mask_].value;
+        std::uint64_t const old = slot.fetch_add(n, std::memory_order_relaxed);
+        if (old < spill_threshold && old + n >= spill_threshold) {
+            this->spill(slot);
+        }
+    }
+
+    void add(uint128_t const n) noexcept {
+        if (n.upper()) {
+            static_cast<void>(this->total_.fetch_add(n));
+        } else {
+            this->add(n.lower());
+        }
+    }
+
+    void operator+=(uint128_t const n) noexcept {
+        this->add(n);
+    }
+
+    [[nodiscard]] auto read() const noexcept -> uint128_t {
+        for (;;) {
+            std::uint64_t const started = this->spills_started_.load();
+            if (this->spills_finished_.load() != started) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            uint128_t sum = this->total_.load();
+            for (std::size_t i = 0; i <= this->mask_; ++i) {
+                sum += this->slots_[i].value.load();
+            }
+
+            if (this->spills_started_.load() == started) {
+                return sum;
+            }
+        }
+    }
+
+private:
+    static constexpr std::uint64_t spill_threshold = std::uint64_t{ 1 } << 63;
+    static constexpr std::uint64_t direct_threshold = std::uint64_t{ 1 } << 56;
+
+    // Moves 2^63 from `slot` to the total.
+    void spill(std::atomic<std::uint64_t> & slot) noexcept {
+        this->spills_started_.fetch_add(1);
+        static_cast<void>(this->total_.fetch_add(spill_threshold));
+        slot.fetch_sub(spill_threshold);
+        this->spills_finished_.fetch_add(1);
+    }
+
+    std::size_t mask_;
+    std::unique_ptr<uint128::details::counter_slot[]> slots_;
+    atomic_uint128 total_;
+    std::atomic<std::uint64_t> spills_started_{ 0 };
+    std::atomic<std::uint64_t> spills_finished_{ 0 };
+};
+
+#endif
@@ -0,0 +1,193 @@
+// Copyright(c) 2023 - present, Payton Wu (payton.wu@outlook.com) & the contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+// Division by a runtime-invariant divisor, in the style of libdivide.
+//
+// The constructor precomputes a magic multiplier and a shift once; every division afterwards
+// is a 128x128 multiply-high, an optional add-and-halve step and a shift.
+//
+//   uint128_divider const by_shards{ shard_count };
+//   for (auto & key : keys) {
+//       key = key / by_shards;
+//   }
+
+#if !defined(UINT128_DIVIDER_H)
+#define UINT128_DIVIDER_H  // NOLINT(clang-diagnostic-unused-macros)
+#pragma once
+
+#include "uint128.h"
+
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+
+namespace uint128::details {
+
+// floor(2^(128 + k) / divisor) and its remainder, where 2^k < divisor.
+// Runs once per divider, so a shift-subtract loop is good enough here.
+[[nodiscard]] constexpr auto divide_pow2_128(unsigned const k, uint128_t const divisor) noexcept -> uint128_div_t {
+    uint128_t rem = uint128_1 << k;
+    uint128_t quot{ 0 };
+    for (int i = 0; i < 128; ++i) {
+        bool const carry = rem.upper() >> 63;
+        rem <<= 1;
+        quot <<= 1;
+        if (carry || rem >= divisor) {
+            rem -= divisor;
+            quot |= 1;
+        }
+    }
+    return { quot, rem };
+}
+
+struct divider_params {
+    uint128_t magic;  // 0 for powers of two
+    uint8_t shift;
+    bool add;         // 129-bit magic: use the add-and-halve step before shifting
+};
+
+// Magic multiplier and shift for dividing by `divisor` (!= 0; != 1 when branchfree).
+// A branchfree divider always takes the add-and-halve step, so it never uses the
+// cheaper 128-bit magic and shifts powers of two by one less.
+[[nodiscard]] constexpr auto make_divider_params(uint128_t const divisor, bool const branchfree) noexcept -> divider_params {
+    auto const floor_log2 = static_cast<uint8_t>(divisor.bits() - 1);
+
+    if (!(divisor & (divisor - 1))) {
+        return { uint128_t{ 0 }, static_cast<uint8_t>(floor_log2 - (branchfree ? 1 : 0)), branchfree };
+    }
+
+    auto [magic, rem] = divide_pow2_128(floor_log2, divisor);
+    uint128_t const error = divisor - rem;
+
+    if (!branchfree && error < (uint128_1 << floor_log2)) {
+        // 2^floor_log2 works, the magic fits in 128 bits
+        return { magic + 1, floor_log2, false };
+    }
+
+    // use 2^(floor_log2 + 1) and a 129-bit magic whose top bit is implied by the add step
+    magic += magic;
+    uint128_t const twice_rem = rem + rem;
+    if (twice_rem >= divisor || twice_rem < rem) {
+        magic += 1;
+    }
+    return { magic + 1, floor_log2, true };
+}
+
+// (numerator * magic) >> (128 + shift), with the 129-bit magic handled by the add step.
+[[nodiscard]] constexpr auto divide_magic(uint128_t const numerator, uint128_t const magic, uint8_t const shift, bool const add) noexcept -> uint128_t {
+    uint128_t const q = ::mulhi(magic, numerator);
+    if (add) {
+        return (((numerator - q) >> 1) + q) >> shift;
+    }
+    return q >> shift;
+}
+
+}
+
+// BranchFree == false: the divide path branches on the kind of divisor (power of two,
+// magic that fits in 128 bits, 129-bit magic). Fastest when the divisor is fixed for a loop.
+// BranchFree == true: every divisor takes the same multiply / add / shift sequence, so
+// the divide has no data-dependent branches. The divisor must not be 1.
+template <bool BranchFree>
+class basic_uint128_divider {
+public:
+    constexpr explicit basic_uint128_divider(uint128_t const divisor) : divisor_{ divisor } {
+        if (!divisor) {
+            throw std::domain_error("Error: division or modulus by 0");
+        }
+
+        if constexpr (BranchFree) {
+            if (divisor == 1) {
+                throw std::invalid_argument("Error: branchfree divider must be != 1");
+            }
+        }
+
+        auto const params = uint128::details::make_divider_params(divisor, BranchFree);
+        this->magic_ = params.magic;
+        this->more_ = static_cast<uint8_t>(params.shift | (params.add && !BranchFree ? add_marker : 0));
+    }
+
+    [[nodiscard]] constexpr auto divisor() const noexcept -> uint128_t {
+        return this->divisor_;
+    }
+
+    [[nodiscard]] constexpr auto divide(uint128_t const numerator) const noexcept -> uint128_t {
+        if constexpr (BranchFree) {
+            return uint128::details::divide_magic(numerator, this->magic_, this->more_, true);
+        } else {
+            if (!this->magic_) {
+                return numerator >> this->more_;
+            }
+
+            return uint128::details::divide_magic(numerator, this->magic_, this->more_ & shift_mask, this->more_ & add_marker);
+        }
+    }
+
+    [[nodiscard]] constexpr auto divmod(uint128_t const numerator) const noexcept -> uint128_div_t {
+        uint128_t const quot = this->divide(numerator);
+        return { quot, numerator - quot * this->divisor_ };
+    }
+
+private:
+    static constexpr uint8_t shift_mask = 0x7f;
+    static constexpr uint8_t add_marker = 0x80;
+
+    uint128_t divisor_;
+    uint128_t magic_{ 0 };
+    uint8_t more_{ 0 };
+};
+
+using uint128_divider = basic_uint128_divider<false>;
+using uint128_branchfree_divider = basic_uint128_divider<true>;
+
+template <bool BranchFree>
+constexpr auto operator/(uint128_t const lhs, basic_uint128_divider<BranchFree> const & rhs) noexcept -> uint128_t {
+    return rhs.divide(lhs);
+}
+
+template <bool BranchFree>
+constexpr auto operator/=(uint128_t & lhs, basic_uint128_divider<BranchFree> const & rhs) noexcept -> uint128_t & {
+    return lhs = rhs.divide(lhs);
+}
+
+template <bool BranchFree>
+constexpr auto operator%(uint128_t const lhs, basic_uint128_divider<BranchFree> const & rhs) noexcept -> uint128_t {
+    return rhs.divmod(lhs).rem;
+}
+
+template <bool BranchFree>
+constexpr auto operator%=(uint128_t & lhs, basic_uint128_divider<BranchFree> const & rhs) noexcept -> uint128_t & {
+    return lhs = rhs.divmod(lhs).rem;
+}
+
+// Division by a compile-time constant. The magic multiplier and shift are computed during
+// compilation, so the division is a multiply-high and shifts (or a single shift for powers of two).
+//
+//   auto const seconds = divide_by<uint128_t{ 1'000'000'000 }>(nanoseconds);
+template <uint128_t Divisor>
+[[nodiscard]] constexpr auto divide_by(uint128_t const numerator) noexcept -> uint128_t {
+    static_assert(Divisor != 0, "Error: division or modulus by 0");
+
+    constexpr auto params = uint128::details::make_divider_params(Divisor, false);
+    if constexpr (!params.magic) {
+        return numerator >> params.shift;
+    } else if constexpr (params.add) {
+        uint128_t const q = ::mulhi(params.magic, numerator);
+        return (((numerator - q) >> 1) + q) >> params.shift;
+    } else {
+        return ::mulhi(params.magic, numerator) >> params.shift;
+    }
+}
+
+template <uint128_t Divisor>
+[[nodiscard]] constexpr auto mod_by(uint128_t const numerator) noexcept -> uint128_t {
+    static_assert(Divisor != 0, "Error: division or modulus by 0");
+
+    if constexpr (!(Divisor & (Divisor - 1))) {
+        return numerator & (Divisor - 1);
+    } else {
+        return numerator - divide_by<Divisor>(numerator) * Divisor;
+    }
+}
+
+#endif
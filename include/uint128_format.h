@@ -0,0 +1,313 @@
+// Copyright(c) 2023 - present, Payton Wu (payton.wu@outlook.com) & the contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+// std::format support for uint128_t.
+//
+// The full standard format spec for integers is accepted:
+// [[fill]align][sign][#][0][width][L][type], with width as a number or a nested {} / {n}
+// and type one of b B d o x X. Output is written straight to the format context's
+// iterator through the to_chars kernels, without allocating (except that the "L" option
+// reads the digit grouping from the locale's std::numpunct).
+//
+//   std::format("{:#034x}", key);   // 0x0000000000000000000000000000002a
+//   std::format("{:_^{}}", id, 44);
+//
+// The spec parsing and padding logic lives in uint128::details and does not need <format>,
+// so it is available (and tested) with standard libraries that do not ship <format> yet.
+
+#if !defined(UINT128_FORMAT_H)
+#define UINT128_FORMAT_H  // NOLINT(clang-diagnostic-unused-macros)
+#pragma once
+
+#include "uint128.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#if __has_include(<format>)
+#   include <format>
+#endif
+
+#if defined(__cpp_lib_format)
+#   include <locale>
+#   include <utility>
+#endif
+
+namespace uint128::details {
+
+// Format argument holding the width, for "{:{}}" (next argument) and "{:{n}}".
+inline constexpr int no_arg_id = -1;
+inline constexpr int automatic_arg_id = -2;
+
+struct format_spec {
+    char fill[4] = { ' ' };  // one UTF-8 encoded character
+    std::uint8_t fill_size = 1;
+    char align = 0;          // '<', '>', '^' or 0 for the default (right, honoring '0')
+    char sign = '-';         // '+', '-' or ' '
+    bool alternate = false;  // '#': 0b / 0B / 0 / 0x / 0X prefix
+    bool zero_pad = false;
+    bool localized = false;  // 'L': digit group separators of the locale
+    char type = 'd';
+    std::size_t width = 0;
+    int width_arg = no_arg_id;
+};
+
+struct format_spec_result {
+    char const * ptr;    // the closing '}' or `last`
+    char const * error;  // nullptr on success
+};
+
+// Length of the UTF-8 sequence starting with `lead`; 1 for anything that is not a lead byte.
+constexpr auto utf8_sequence_length(char const lead) noexcept -> std::size_t {
+    auto const byte = static_cast<unsigned char>(lead);
+    if ((byte & 0xe0) == 0xc0) {
+        return 2;
+    }
+    if ((byte & 0xf0) == 0xe0) {
+        return 3;
+    }
+    if ((byte & 0xf8) == 0xf0) {
+        return 4;
+    }
+    return 1;
+}
+
+// Parses a non-negative decimal number for the width or an argument id.
+constexpr auto parse_spec_number(char const * & p, char const * const last, std::size_t & number) noexcept -> bool {
+    number = 0;
+    for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+        number = number * 10 + static_cast<std::size_t>(*p - '0');
+        if (number > INT_MAX) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Parses [[fill]align][sign][#][0][width][L][type] from [first, last) into `spec`.
+constexpr auto parse_format_spec(char const * const first, char const * const last, format_spec & spec) noexcept -> format_spec_result {
+    auto const is_align = [](char const c) {
+        return c == '<' || c == '>' || c == '^';
+    };
+
+    char const * p = first;
+    if (p == last || *p == '}') {
+        return { p, nullptr };
+    }
+
+    if (auto const n = utf8_sequence_length(*p); static_cast<std::size_t>(last - p) > n && is_align(p[n])) {
+        if (*p == '{' || *p == '}') {
+            return { p, "invalid fill character in format spec" };
+        }
+        std::copy_n(p, n, spec.fill);
+        spec.fill_size = static_cast<std::uint8_t>(n);
+        spec.align = p[n];
+        p += n + 1;
+    } else if (is_align(*p)) {
+        spec.align = *p++;
+    }
+
+    if (p != last && (*p == '+' || *p == '-' || *p == ' ')) {
+        spec.sign = *p++;
+    }
+    if (p != last && *p == '#') {
+        spec.alternate = true;
+        ++p;
+    }
+    if (p != last && *p == '0') {
+        spec.zero_pad = true;
+        ++p;
+    }
+
+    if (p != last && *p >= '1' && *p <= '9') {
+        if (!parse_spec_number(p, last, spec.width)) {
+            return { p, "width is too large in format spec" };
+        }
+    } else if (p != last && *p == '{') {
+        ++p;
+        if (p != last && *p == '}') {
+            spec.width_arg = automatic_arg_id;
+        } else {
+            std::size_t id = 0;
+            if (p == last || *p < '0' || *p > '9' || !parse_spec_number(p, last, id) || p == last || *p != '}') {
+                return { p, "invalid width argument in format spec" };
+            }
+            spec.width_arg = static_cast<int>(id);
+        }
+        ++p;
+    }
+
+    if (p != last && *p == '.') {
+        return { p, "precision is not allowed for integers" };
+    }
+    if (p != last && *p == 'L') {
+        spec.localized = true;
+        ++p;
+    }
+    if (p != last && std::string_view("bBdoxX").find(*p) != std::string_view::npos) {
+        spec.type = *p++;
+    }
+
+    if (p != last && *p != '}') {
+        return { p, "invalid format spec for uint128_t" };
+    }
+    return { p, nullptr };
+}
+
+// Inserts `separator` into the digits [first, last) following a std::numpunct grouping
+// string (group sizes from the right, the last one repeats, CHAR_MAX or <= 0 ends grouping).
+// Writes to `out`, which must hold (last - first) * 2 characters. Returns the end of the output.
+constexpr auto group_digits(char const * first, char const * last, char * out, char const separator, std::string_view const grouping) noexcept -> char * {
+    // collect the group boundaries from the right, then copy left to right
+    std::size_t sizes[128]{};
+    std::size_t groups = 0;
+    auto remaining = static_cast<std::size_t>(last - first);
+    for (std::size_t i = 0; remaining; ++groups) {
+        auto const size = static_cast<signed char>(grouping[std::min(i, grouping.size() - 1)]);
+        if (size <= 0 || size == CHAR_MAX || static_cast<std::size_t>(size) >= remaining) {
+            sizes[groups] = remaining;
+            remaining = 0;
+        } else {
+            sizes[groups] = static_cast<std::size_t>(size);
+            remaining -= sizes[groups];
+        }
+        i += i < grouping.size();
+    }
+
+    while (groups--) {
+        out = std::copy_n(first, sizes[groups], out);
+        first += sizes[groups];
+        if (groups) {
+            *out++ = separator;
+        }
+    }
+    return out;
+}
+
+// Writes `value` to `out` as described by `spec`, padded to `width` columns.
+// `separator` and `grouping` are only used when spec.localized is set.
+template <typename Out>
+constexpr auto format_uint128(Out out, uint128_t const value, format_spec const & spec, std::size_t const width,
+                              char const separator = ',', std::string_view const grouping = {}) -> Out {
+    // the prefix is a sign and / or a base prefix
+    char prefix[3]{};
+    std::size_t prefix_size = 0;
+    if (spec.sign != '-') {
+        prefix[prefix_size++] = spec.sign;
+    }
+
+    int base = 10;
+    switch (spec.type) {
+    case 'b':
+    case 'B':
+        base = 2;
+        break;
+    case 'o':
+        base = 8;
+        break;
+    case 'x':
+    case 'X':
+        base = 16;
+        break;
+    default:
+        break;
+    }
+
+    if (spec.alternate && base != 10) {
+        prefix[prefix_size++] = '0';
+        if (base != 8) {
+            prefix[prefix_size++] = spec.type;
+        } else if (!value) {
+            --prefix_size;  // octal zero is already "0"
+        }
+    }
+
+    char digits[128];
+    char * digits_last = spec.type == 'X' ? to_hex_chars(std::begin(digits), std::end(digits), value, 1, true).ptr
+                                          : to_chars(std::begin(digits), std::end(digits), value, base).ptr;
+    char const * digits_first = digits;
+
+    char grouped[256];
+    if (spec.localized && !grouping.empty()) {
+        digits_last = group_digits(digits_first, digits_last, grouped, separator, grouping);
+        digits_first = grouped;
+    }
+
+    auto const size = prefix_size + static_cast<std::size_t>(digits_last - digits_first);
+    std::size_t const padding = width > size ? width - size : 0;
+
+    auto const fill = [&](Out it, std::size_t const count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            it = std::copy_n(spec.fill, spec.fill_size, it);
+        }
+        return it;
+    };
+
+    if (!spec.align && spec.zero_pad) {
+        out = std::copy_n(prefix, prefix_size, out);
+        out = std::fill_n(out, padding, '0');
+        return std::copy(digits_first, static_cast<char const *>(digits_last), out);
+    }
+
+    std::size_t const before = spec.align == '<' ? 0 : spec.align == '^' ? padding / 2 : padding;
+    out = fill(out, before);
+    out = std::copy_n(prefix, prefix_size, out);
+    out = std::copy(digits_first, static_cast<char const *>(digits_last), out);
+    return fill(out, padding - before);
+}
+
+}
+
+#if defined(__cpp_lib_format)
+
+template <>
+struct std::formatter<uint128_t, char> {
+    constexpr auto parse(std::format_parse_context & ctx) -> std::format_parse_context::iterator {
+        auto const [ptr, error] = uint128::details::parse_format_spec(std::to_address(ctx.begin()), std::to_address(ctx.end()), this->spec_);
+        if (error) {
+            throw std::format_error(error);
+        }
+
+        if (this->spec_.width_arg == uint128::details::automatic_arg_id) {
+            this->spec_.width_arg = static_cast<int>(ctx.next_arg_id());
+        } else if (this->spec_.width_arg != uint128::details::no_arg_id) {
+            ctx.check_arg_id(static_cast<std::size_t>(this->spec_.width_arg));
+        }
+        return ctx.begin() + (ptr - std::to_address(ctx.begin()));
+    }
+
+    template <typename FormatContext>
+    auto format(uint128_t const value, FormatContext & ctx) const -> typename FormatContext::iterator {
+        std::size_t width = this->spec_.width;
+        if (this->spec_.width_arg != uint128::details::no_arg_id) {
+            width = std::visit_format_arg([](auto const arg) -> std::size_t {
+                using T = std::remove_cv_t<decltype(arg)>;
+                if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>) {
+                    if (std::cmp_less(arg, 0)) {
+                        throw std::format_error("negative width for uint128_t");
+                    }
+                    return static_cast<std::size_t>(arg);
+                } else {
+                    throw std::format_error("width argument is not an integer");
+                }
+            }, ctx.arg(static_cast<std::size_t>(this->spec_.width_arg)));
+        }
+
+        if (this->spec_.localized) {
+            auto const & punct = std::use_facet<std::numpunct<char>>(ctx.locale());
+            return uint128::details::format_uint128(ctx.out(), value, this->spec_, width, punct.thousands_sep(), punct.grouping());
+        }
+        return uint128::details::format_uint128(ctx.out(), value, this->spec_, width);
+    }
+
+private:
+    uint128::details::format_spec spec_;
+};
+
+#endif
+
+#endif
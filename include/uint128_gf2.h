@@ -0,0 +1,364 @@
+// Copyright(c) 2023 - present, Payton Wu (payton.wu@outlook.com) & the contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+// Carry-less (GF(2)[x] polynomial) multiplication and the field GF(2^128), for GHASH /
+// POLYVAL-style authenticators and CRC folding on 128-bit blocks.
+//
+//   clmul(a, b)              64 x 64 -> 128-bit carry-less product.
+//   clmul_wide(a, b)         128 x 128 -> 256-bit carry-less product, three 64-bit products.
+//   gf2_128                  GF(2)[x] / (x^128 + x^7 + x^2 + x + 1), bit i of bits() holding the
+//                            coefficient of x^i. + is xor, * is clmul_wide and a reduction.
+//   gf2_128_key              h, h^2, ..., h^8 for a hash key h. absorb(acc, blocks) runs
+//                            acc = (acc + block) * h over the blocks, summing up to eight
+//                            unreduced products and reducing once per group of blocks.
+//
+// GHASH (AES-GCM) works in this field with the bits of each 16-byte block reflected: use
+// bit_reverse(uint128_t::from_bytes(block)) for blocks and the key, and bit_reverse the result.
+//
+// The scalar functions use PCLMULQDQ (x86-64) or PMULL (AArch64) when compiled for them, and
+// otherwise integer multiplies on operands with holes between their bits, which runs in
+// constant time like the instructions. absorb() picks a VPCLMULQDQ (AVX-512, four blocks per
+// instruction), PCLMULQDQ or portable kernel at runtime on x86-64.
+
+#if !defined(UINT128_GF2_H)
+#define UINT128_GF2_H  // NOLINT(clang-diagnostic-unused-macros)
+#pragma once
+
+#include "uint128.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#if defined(__PCLMUL__) && (defined(__x86_64__) || defined(_M_X64))
+#   define UINT128_GF2_HAS_PCLMUL 1
+#   include <immintrin.h>
+#elif defined(__ARM_FEATURE_AES) && defined(__aarch64__)
+#   define UINT128_GF2_HAS_PMULL 1
+#   include <arm_neon.h>
+#endif
+
+// Kernels compiled for newer instruction sets with target attributes and picked at runtime.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#   define UINT128_GF2_X86_DISPATCH 1
+#   include <immintrin.h>
+#endif
+
+namespace uint128::details {
+
+// 32 x 32 -> 64-bit carry-less product. Each operand is split into four parts with one bit
+// in every four; an integer product of two parts sums at most 8 bits per position, so the
+// carries never reach the next position of the same residue and masking removes them.
+constexpr auto clmul32_portable(std::uint32_t const x, std::uint32_t const y) noexcept -> std::uint64_t {
+    std::uint64_t const x0 = x & 0x11111111u;
+    std::uint64_t const x1 = x & 0x22222222u;
+    std::uint64_t const x2 = x & 0x44444444u;
+    std::uint64_t const x3 = x & 0x88888888u;
+    std::uint64_t const y0 = y & 0x11111111u;
+    std::uint64_t const y1 = y & 0x22222222u;
+    std::uint64_t const y2 = y & 0x44444444u;
+    std::uint64_t const y3 = y & 0x88888888u;
+    std::uint64_t const z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+    std::uint64_t const z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+    std::uint64_t const z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+    std::uint64_t const z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+    return (z0 & 0x1111111111111111ULL) | (z1 & 0x2222222222222222ULL) | (z2 & 0x4444444444444444ULL) | (z3 & 0x8888888888888888ULL);
+}
+
+// Karatsuba over 32-bit halves.
+constexpr auto clmul64_portable(std::uint64_t const a, std::uint64_t const b, std::uint64_t & hi) noexcept -> std::uint64_t {
+    auto const a0 = static_cast<std::uint32_t>(a);
+    auto const a1 = static_cast<std::uint32_t>(a >> 32);
+    auto const b0 = static_cast<std::uint32_t>(b);
+    auto const b1 = static_cast<std::uint32_t>(b >> 32);
+    std::uint64_t const low = clmul32_portable(a0, b0);
+    std::uint64_t const high = clmul32_portable(a1, b1);
+    std::uint64_t const middle = clmul32_portable(a0 ^ a1, b0 ^ b1) ^ low ^ high;
+    hi = high ^ (middle >> 32);
+    return low ^ (middle << 32);
+}
+
+// 64 x 64 -> 128-bit carry-less product. Returns the low 64 bits, the high 64 bits are
+// stored into `hi`.
+constexpr auto clmul64(std::uint64_t const a, std::uint64_t const b, std::uint64_t & hi) noexcept -> std::uint64_t {
+#if defined(UINT128_GF2_HAS_PCLMUL)
+    if (!std::is_constant_evaluated()) {
+        __m128i const product = _mm_clmulepi64_si128(_mm_cvtsi64_si128(static_cast<long long>(a)), _mm_cvtsi64_si128(static_cast<long long>(b)), 0x00);
+        hi = static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(product, product)));
+        return static_cast<std::uint64_t>(_mm_cvtsi128_si64(product));
+    }
+#elif defined(UINT128_GF2_HAS_PMULL)
+    if (!std::is_constant_evaluated()) {
+        uint64x2_t const product = vreinterpretq_u64_p128(vmull_p64(a, b));
+        hi = vgetq_lane_u64(product, 1);
+        return vgetq_lane_u64(product, 0);
+    }
+#endif
+    return clmul64_portable(a, b, hi);
+}
+
+// 128 x 128 -> 256-bit carry-less product, least significant word first, xor-ed into
+// `product` so that several products can be summed before one reduction.
+constexpr void clmul128_accumulate(std::uint64_t const au, std::uint64_t const al, std::uint64_t const bu, std::uint64_t const bl, std::uint64_t (&product)[4]) noexcept {
+    std::uint64_t low_hi{};
+    std::uint64_t high_hi{};
+    std::uint64_t middle_hi{};
+    std::uint64_t const low_lo = clmul64(al, bl, low_hi);
+    std::uint64_t const high_lo = clmul64(au, bu, high_hi);
+    std::uint64_t middle_lo = clmul64(al ^ au, bl ^ bu, middle_hi);
+    middle_lo ^= low_lo ^ high_lo;
+    middle_hi ^= low_hi ^ high_hi;
+    product[0] ^= low_lo;
+    product[1] ^= low_hi ^ middle_lo;
+    product[2] ^= high_lo ^ middle_hi;
+    product[3] ^= high_hi;
+}
+
+// A 256-bit carry-less product modulo x^128 + x^7 + x^2 + x + 1. The upper half times x^128
+// is the upper half times x^7 + x^2 + x + 1; the up to 7 bits of that which pass x^128 are
+// folded into the upper half first, since the same multiplication leaves them below x^14.
+constexpr auto gf2_128_reduce(std::uint64_t const (&product)[4]) noexcept -> uint128_t {
+    std::uint64_t const over = (product[3] >> 63) ^ (product[3] >> 62) ^ (product[3] >> 57);
+    std::uint64_t const v0 = product[2] ^ over;
+    std::uint64_t const v1 = product[3];
+    std::uint64_t const r0 = v0 ^ (v0 << 1) ^ (v0 << 2) ^ (v0 << 7);
+    std::uint64_t const r1 = v1 ^ ((v1 << 1) | (v0 >> 63)) ^ ((v1 << 2) | (v0 >> 62)) ^ ((v1 << 7) | (v0 >> 57));
+    return { product[1] ^ r1, product[0] ^ r0 };
+}
+
+}
+
+// 64 x 64 -> 128-bit carry-less product.
+[[nodiscard]] constexpr auto clmul(std::uint64_t const a, std::uint64_t const b) noexcept -> uint128_t {
+    std::uint64_t hi{};
+    std::uint64_t const lo = uint128::details::clmul64(a, b, hi);
+    return { hi, lo };
+}
+
+// 128 x 128 -> 256-bit carry-less product, most significant half first like mul_wide.
+[[nodiscard]] constexpr auto clmul_wide(uint128_t const a, uint128_t const b) noexcept -> uint128_wide_t {
+    std::uint64_t product[4]{};
+    uint128::details::clmul128_accumulate(a.upper(), a.lower(), b.upper(), b.lower(), product);
+    return { { product[3], product[2] }, { product[1], product[0] } };
+}
+
+class gf2_128 {
+public:
+    constexpr gf2_128() noexcept = default;
+
+    constexpr explicit gf2_128(uint128_t const bits) noexcept : bits_(bits) {
+    }
+
+    [[nodiscard]] constexpr auto bits() const noexcept -> uint128_t {
+        return this->bits_;
+    }
+
+    constexpr auto operator+=(gf2_128 const rhs) noexcept -> gf2_128 & {
+        this->bits_ ^= rhs.bits_;
+        return *this;
+    }
+
+    // Subtraction is addition in characteristic 2.
+    constexpr auto operator-=(gf2_128 const rhs) noexcept -> gf2_128 & {
+        return *this += rhs;
+    }
+
+    constexpr auto operator*=(gf2_128 const rhs) noexcept -> gf2_128 & {
+        std::uint64_t product[4]{};
+        uint128::details::clmul128_accumulate(this->bits_.upper(), this->bits_.lower(), rhs.bits_.upper(), rhs.bits_.lower(), product);
+        this->bits_ = uint128::details::gf2_128_reduce(product);
+        return *this;
+    }
+
+    [[nodiscard]] constexpr auto operator+(gf2_128 const rhs) const noexcept -> gf2_128 {
+        return gf2_128{ *this } += rhs;
+    }
+
+    [[nodiscard]] constexpr auto operator-(gf2_128 const rhs) const noexcept -> gf2_128 {
+        return gf2_128{ *this } -= rhs;
+    }
+
+    [[nodiscard]] constexpr auto operator*(gf2_128 const rhs) const noexcept -> gf2_128 {
+        return gf2_128{ *this } *= rhs;
+    }
+
+    [[nodiscard]] constexpr auto pow(uint128_t exponent) const noexcept -> gf2_128 {
+        gf2_128 result{ uint128_1 };
+        gf2_128 base = *this;
+        for (; exponent; exponent >>= 1) {
+            if (exponent.lower() & 1) {
+                result *= base;
+            }
+            base *= base;
+        }
+        return result;
+    }
+
+    // a^(2^128 - 2), which is 1 / a for a != 0 and 0 for a == 0.
+    [[nodiscard]] constexpr auto inverse() const noexcept -> gf2_128 {
+        return this->pow(uint128_t(0xffffffffffffffffULL, 0xfffffffffffffffeULL));
+    }
+
+    constexpr auto operator==(gf2_128 const & rhs) const noexcept -> bool = default;
+
+private:
+    uint128_t bits_{ 0 };
+};
+
+namespace uint128::details {
+
+// acc = (acc + block) * h over `count` blocks, for powers = { h^8, h^7, ..., h }. A group of
+// n blocks is acc' = (acc + b0) * h^n + b1 * h^(n-1) + ... + b(n-1) * h, one reduction.
+constexpr auto gf2_128_absorb_portable(uint128_t const * const powers, uint128_t acc, uint128_t const * blocks, std::size_t count) noexcept -> uint128_t {
+    while (count) {
+        std::size_t const n = count >= 8 ? 8 : count >= 4 ? 4 : 1;
+        uint128_t const * const h = powers + 8 - n;
+        std::uint64_t product[4]{};
+        for (std::size_t j = 0; j < n; ++j) {
+            uint128_t const x = j ? blocks[j] : blocks[j] ^ acc;
+            clmul128_accumulate(x.upper(), x.lower(), h[j].upper(), h[j].lower(), product);
+        }
+        acc = gf2_128_reduce(product);
+        blocks += n;
+        count -= n;
+    }
+    return acc;
+}
+
+#if defined(UINT128_GF2_X86_DISPATCH)
+// Sums of the four 64 x 64 products of a block and a power, kept apart: low, high and the two
+// cross products, which only need combining and shifting once per group.
+struct gf2_128_sums_sse {
+    __m128i low;
+    __m128i high;
+    __m128i middle;
+};
+
+__attribute__((target("pclmul"))) inline void gf2_128_accumulate_sse(gf2_128_sums_sse & sums, __m128i const x, __m128i const y) noexcept {
+    sums.low = _mm_xor_si128(sums.low, _mm_clmulepi64_si128(x, y, 0x00));
+    sums.high = _mm_xor_si128(sums.high, _mm_clmulepi64_si128(x, y, 0x11));
+    sums.middle = _mm_xor_si128(sums.middle, _mm_xor_si128(_mm_clmulepi64_si128(x, y, 0x01), _mm_clmulepi64_si128(x, y, 0x10)));
+}
+
+// The two steps of gf2_128_reduce with carry-less multiplies by x^7 + x^2 + x + 1 (0x87): the
+// top 64 bits of the product times x^192 first, which leaves at most 7 bits above x^191, then
+// the 64 bits above x^128.
+__attribute__((target("pclmul"))) inline auto gf2_128_reduce_sse(gf2_128_sums_sse const & sums) noexcept -> __m128i {
+    __m128i const polynomial = _mm_cvtsi64_si128(0x87);
+    __m128i low = _mm_xor_si128(sums.low, _mm_slli_si128(sums.middle, 8));
+    __m128i high = _mm_xor_si128(sums.high, _mm_srli_si128(sums.middle, 8));
+    __m128i const top = _mm_clmulepi64_si128(high, polynomial, 0x01);
+    low = _mm_xor_si128(low, _mm_slli_si128(top, 8));
+    high = _mm_xor_si128(high, _mm_srli_si128(top, 8));
+    return _mm_xor_si128(low, _mm_clmulepi64_si128(high, polynomial, 0x00));
+}
+
+__attribute__((target("pclmul"))) inline auto gf2_128_absorb_sse(uint128_t const * const powers, __m128i acc, uint128_t const * blocks, std::size_t count) noexcept -> __m128i {
+    while (count) {
+        std::size_t const n = count >= 8 ? 8 : count >= 4 ? 4 : 1;
+        uint128_t const * const h = powers + 8 - n;
+        gf2_128_sums_sse sums{ _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+        for (std::size_t j = 0; j < n; ++j) {
+            gf2_128_accumulate_sse(sums, _mm_loadu_si128(reinterpret_cast<__m128i const *>(blocks + j)), _mm_loadu_si128(reinterpret_cast<__m128i const *>(h + j)));
+        }
+        // acc * h^n separately, so that only this product waits for the previous group
+        gf2_128_accumulate_sse(sums, acc, _mm_loadu_si128(reinterpret_cast<__m128i const *>(h)));
+        acc = gf2_128_reduce_sse(sums);
+        blocks += n;
+        count -= n;
+    }
+    return acc;
+}
+
+// uint128_t is two little-endian words, lower first, on x86-64: the layout of an __m128i.
+__attribute__((target("pclmul"))) inline auto gf2_128_absorb_pclmul(uint128_t const * const powers, uint128_t acc, uint128_t const * const blocks, std::size_t const count) noexcept -> uint128_t {
+    __m128i const result = gf2_128_absorb_sse(powers, _mm_loadu_si128(reinterpret_cast<__m128i const *>(&acc)), blocks, count);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(&acc), result);
+    return acc;
+}
+
+// The xor of the four 128-bit lanes.
+__attribute__((target("avx512f"))) inline auto gf2_128_fold_lanes(__m512i const v) noexcept -> __m128i {
+    // through memory: GCC 12 warns about the lane extract and shuffle intrinsics at -O2
+    alignas(64) __m128i lanes[4];
+    _mm512_store_si512(lanes, v);
+    return _mm_xor_si128(_mm_xor_si128(lanes[0], lanes[1]), _mm_xor_si128(lanes[2], lanes[3]));
+}
+
+// Groups of eight blocks as two vectors of four; the tail goes to the PCLMULQDQ loop.
+__attribute__((target("pclmul,avx512f,vpclmulqdq"))) inline auto gf2_128_absorb_vpclmul(uint128_t const * const powers, uint128_t acc, uint128_t const * blocks, std::size_t count) noexcept -> uint128_t {
+    __m512i const h_first = _mm512_loadu_si512(powers);
+    __m512i const h_second = _mm512_loadu_si512(powers + 4);
+    __m128i sum = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&acc));
+    for (; count >= 8; blocks += 8, count -= 8) {
+        __m512i const first = _mm512_loadu_si512(blocks);
+        __m512i const second = _mm512_loadu_si512(blocks + 4);
+        __m512i const low = _mm512_xor_si512(_mm512_clmulepi64_epi128(first, h_first, 0x00), _mm512_clmulepi64_epi128(second, h_second, 0x00));
+        __m512i const high = _mm512_xor_si512(_mm512_clmulepi64_epi128(first, h_first, 0x11), _mm512_clmulepi64_epi128(second, h_second, 0x11));
+        __m512i const middle = _mm512_xor_si512(
+            _mm512_xor_si512(_mm512_clmulepi64_epi128(first, h_first, 0x01), _mm512_clmulepi64_epi128(first, h_first, 0x10)),
+            _mm512_xor_si512(_mm512_clmulepi64_epi128(second, h_second, 0x01), _mm512_clmulepi64_epi128(second, h_second, 0x10)));
+        gf2_128_sums_sse sums{ gf2_128_fold_lanes(low), gf2_128_fold_lanes(high), gf2_128_fold_lanes(middle) };
+        gf2_128_accumulate_sse(sums, sum, _mm_loadu_si128(reinterpret_cast<__m128i const *>(powers)));
+        sum = gf2_128_reduce_sse(sums);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(&acc), gf2_128_absorb_sse(powers, sum, blocks, count));
+    return acc;
+}
+#endif
+
+using gf2_128_absorb_kernel = auto (*)(uint128_t const *, uint128_t, uint128_t const *, std::size_t) noexcept -> uint128_t;
+
+// The widest kernel the running CPU supports.
+inline auto select_gf2_128_absorb() noexcept -> gf2_128_absorb_kernel {
+#if defined(UINT128_GF2_X86_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("vpclmulqdq") && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("pclmul")) {
+        return gf2_128_absorb_vpclmul;
+    }
+    if (__builtin_cpu_supports("pclmul")) {
+        return gf2_128_absorb_pclmul;
+    }
+#endif
+    return gf2_128_absorb_portable;
+}
+
+// The kernel is picked once, outside of constexpr absorb() where a static variable needs C++23.
+inline auto gf2_128_absorb(uint128_t const * const powers, uint128_t const acc, uint128_t const * const blocks, std::size_t const count) noexcept -> uint128_t {
+    static gf2_128_absorb_kernel const kernel = select_gf2_128_absorb();
+    return kernel(powers, acc, blocks, count);
+}
+
+}
+
+class gf2_128_key {
+public:
+    constexpr explicit gf2_128_key(gf2_128 const h) noexcept {
+        gf2_128 power = h;
+        for (std::size_t i = this->powers_.size(); i-- > 0;) {
+            this->powers_[i] = power.bits();
+            power *= h;
+        }
+    }
+
+    [[nodiscard]] constexpr auto h() const noexcept -> gf2_128 {
+        return gf2_128{ this->powers_.back() };
+    }
+
+    // acc = (acc + block) * h for each block in order, e.g. the GHASH or POLYVAL update.
+    [[nodiscard]] constexpr auto absorb(gf2_128 const acc, std::span<uint128_t const> const blocks) const noexcept -> gf2_128 {
+        if (std::is_constant_evaluated()) {
+            return gf2_128{ uint128::details::gf2_128_absorb_portable(this->powers_.data(), acc.bits(), blocks.data(), blocks.size()) };
+        }
+
+        return gf2_128{ uint128::details::gf2_128_absorb(this->powers_.data(), acc.bits(), blocks.data(), blocks.size()) };
+    }
+
+private:
+    // h^8 first, h last: the powers for a group of n blocks are the last n
+    std::array<uint128_t, 8> powers_{};
+};
+
+#endif
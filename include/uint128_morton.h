@@ -0,0 +1,314 @@
+// Copyright(c) 2023 - present, Payton Wu (payton.wu@outlook.com) & the contributors.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+// Bit deposit / extract over 128-bit masks, and Morton (Z-order) and Hilbert keys that map a
+// pair of 64-bit coordinates to one uint128_t, e.g. for spatial or multi-column sort keys.
+//
+//   pdep(x, mask)            the low bits of x scattered, in order, to the set bits of mask.
+//   pext(x, mask)            the bits of x at the set bits of mask, gathered into the low bits.
+//   morton_encode(x, y)      x in the even and y in the odd bits of the key, so bits 2i and
+//                            2i + 1 hold bit i of each coordinate and keys sort in Z-order.
+//   morton_decode(key)       {x, y} back from a Morton key.
+//   hilbert_encode(x, y)     distance of (x, y) along the 2^64 x 2^64 Hilbert curve, one 2-bit
+//                            quadrant digit per level like the Morton layout, most significant
+//                            level first. Points close in the key are close in the plane.
+//   hilbert_decode(key)      {x, y} back from a Hilbert key.
+//
+// The scalar functions run pdep / pext on each 64-bit half when compiled with BMI2, and
+// otherwise spread and compact bits with shift-and-mask ("magic number") steps. The span
+// versions of morton_encode / morton_decode pick the BMI2 kernel at runtime on x86-64, except
+// on AMD CPUs before Zen 3 where pdep and pext are microcoded.
+
+#if !defined(UINT128_MORTON_H)
+#define UINT128_MORTON_H  // NOLINT(clang-diagnostic-unused-macros)
+#pragma once
+
+#include "uint128.h"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+#   define UINT128_MORTON_HAS_BMI2 1
+#   include <immintrin.h>
+#endif
+
+// Kernels compiled for BMI2 with target attributes and picked at runtime.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__) && !defined(UINT128_MORTON_HAS_BMI2)
+#   define UINT128_MORTON_X86_DISPATCH 1
+#   include <immintrin.h>
+#endif
+
+// A pair of 64-bit coordinates.
+struct point64_t {
+    std::uint64_t x;
+    std::uint64_t y;
+
+    constexpr auto operator==(point64_t const & rhs) const noexcept -> bool = default;
+};
+
+namespace uint128::details {
+
+inline constexpr std::uint64_t even_bits64 = 0x5555555555555555ULL;
+inline constexpr std::uint64_t odd_bits64 = 0xaaaaaaaaaaaaaaaaULL;
+
+// One iteration per set bit of `mask`.
+constexpr auto pdep64_portable(std::uint64_t const value, std::uint64_t mask) noexcept -> std::uint64_t {
+    std::uint64_t result = 0;
+    for (std::uint64_t bit = 1; mask; bit += bit) {
+        if (value & bit) {
+            result |= mask & (0 - mask);
+        }
+        mask &= mask - 1;
+    }
+    return result;
+}
+
+constexpr auto pext64_portable(std::uint64_t const value, std::uint64_t mask) noexcept -> std::uint64_t {
+    std::uint64_t result = 0;
+    for (std::uint64_t bit = 1; mask; bit += bit) {
+        if (value & mask & (0 - mask)) {
+            result |= bit;
+        }
+        mask &= mask - 1;
+    }
+    return result;
+}
+
+constexpr auto pdep64(std::uint64_t const value, std::uint64_t const mask) noexcept -> std::uint64_t {
+#if defined(UINT128_MORTON_HAS_BMI2)
+    if (!std::is_constant_evaluated()) {
+        return _pdep_u64(value, mask);
+    }
+#endif
+    return pdep64_portable(value, mask);
+}
+
+constexpr auto pext64(std::uint64_t const value, std::uint64_t const mask) noexcept -> std::uint64_t {
+#if defined(UINT128_MORTON_HAS_BMI2)
+    if (!std::is_constant_evaluated()) {
+        return _pext_u64(value, mask);
+    }
+#endif
+    return pext64_portable(value, mask);
+}
+
+// The low 32 bits of `value` moved to the even bits.
+constexpr auto spread32(std::uint64_t value) noexcept -> std::uint64_t {
+#if defined(UINT128_MORTON_HAS_BMI2)
+    if (!std::is_constant_evaluated()) {
+        return _pdep_u64(value, even_bits64);
+    }
+#endif
+    value &= 0x00000000ffffffffULL;
+    value = (value | (value << 16)) & 0x0000ffff0000ffffULL;
+    value = (value | (value << 8)) & 0x00ff00ff00ff00ffULL;
+    value = (value | (value << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    value = (value | (value << 2)) & 0x3333333333333333ULL;
+    value = (value | (value << 1)) & even_bits64;
+    return value;
+}
+
+// The even bits of `value` packed into the low 32 bits.
+constexpr auto compact32(std::uint64_t value) noexcept -> std::uint64_t {
+#if defined(UINT128_MORTON_HAS_BMI2)
+    if (!std::is_constant_evaluated()) {
+        return _pext_u64(value, even_bits64);
+    }
+#endif
+    value &= even_bits64;
+    value = (value | (value >> 1)) & 0x3333333333333333ULL;
+    value = (value | (value >> 2)) & 0x0f0f0f0f0f0f0f0fULL;
+    value = (value | (value >> 4)) & 0x00ff00ff00ff00ffULL;
+    value = (value | (value >> 8)) & 0x0000ffff0000ffffULL;
+    value = (value | (value >> 16)) & 0x00000000ffffffffULL;
+    return value;
+}
+
+}
+
+[[nodiscard]] constexpr auto pdep(uint128_t const value, uint128_t const mask) noexcept -> uint128_t {
+    // the lower half of the mask takes as many bits of value as it has set bits
+    int const lower_count = std::popcount(mask.lower());
+    uint128_t const rest = value >> lower_count;
+    return { uint128::details::pdep64(rest.lower(), mask.upper()), uint128::details::pdep64(value.lower(), mask.lower()) };
+}
+
+[[nodiscard]] constexpr auto pext(uint128_t const value, uint128_t const mask) noexcept -> uint128_t {
+    uint128_t const upper = uint128::details::pext64(value.upper(), mask.upper());
+    return (upper << std::popcount(mask.lower())) | uint128::details::pext64(value.lower(), mask.lower());
+}
+
+[[nodiscard]] constexpr auto morton_encode(std::uint64_t const x, std::uint64_t const y) noexcept -> uint128_t {
+    using uint128::details::spread32;
+    return { spread32(x >> 32) | (spread32(y >> 32) << 1), spread32(x) | (spread32(y) << 1) };
+}
+
+[[nodiscard]] constexpr auto morton_decode(uint128_t const key) noexcept -> point64_t {
+    using uint128::details::compact32;
+    return {
+        compact32(key.lower()) | (compact32(key.upper()) << 32),
+        compact32(key.lower() >> 1) | (compact32(key.upper() >> 1) << 32),
+    };
+}
+
+namespace uint128::details {
+
+// Hilbert keys are built one level at a time from the most significant bits. The curve's
+// orientation in the current quadrant is a state: whether x and y are swapped and whether
+// both are mirrored. Each table entry covers four levels, indexed by the state and a nibble
+// of each coordinate (encode) or a byte of the key (decode), and holds the eight result bits
+// with the next state in bits 8 and 9.
+struct hilbert_tables {
+    std::array<std::uint16_t, 1024> encode;
+    std::array<std::uint16_t, 1024> decode;
+};
+
+// One level: the raw coordinate bits in, the quadrant digit out, updating the state.
+constexpr auto hilbert_step(unsigned & state, unsigned const bx, unsigned const by) noexcept -> unsigned {
+    unsigned const swapped = state & 1;
+    unsigned const mirrored = state >> 1;
+    unsigned const rx = (swapped ? by : bx) ^ mirrored;
+    unsigned const ry = (swapped ? bx : by) ^ mirrored;
+    if (!ry) {
+        // lower quadrants: mirrored if on the right, always transposed
+        state ^= 1 | (rx << 1);
+    }
+    return (3 * rx) ^ ry;
+}
+
+constexpr auto make_hilbert_tables() noexcept -> hilbert_tables {
+    hilbert_tables tables{};
+    for (unsigned start = 0; start < 4; ++start) {
+        for (unsigned x = 0; x < 16; ++x) {
+            for (unsigned y = 0; y < 16; ++y) {
+                unsigned state = start;
+                unsigned digits = 0;
+                for (int level = 3; level >= 0; --level) {
+                    digits = (digits << 2) | hilbert_step(state, (x >> level) & 1, (y >> level) & 1);
+                }
+                tables.encode[(start << 8) | (x << 4) | y] = static_cast<std::uint16_t>(digits | (state << 8));
+                tables.decode[(start << 8) | digits] = static_cast<std::uint16_t>(((x << 4) | y) | (state << 8));
+            }
+        }
+    }
+    return tables;
+}
+
+inline constexpr hilbert_tables hilbert_table = make_hilbert_tables();
+
+}
+
+[[nodiscard]] constexpr auto hilbert_encode(std::uint64_t const x, std::uint64_t const y) noexcept -> uint128_t {
+    auto const & table = uint128::details::hilbert_table.encode;
+    std::uint64_t digits[2]{};
+    unsigned state = 0;
+    for (int nibble = 15; nibble >= 0; --nibble) {
+        unsigned const index = (state << 8) | static_cast<unsigned>(((x >> (4 * nibble)) & 15) << 4) | static_cast<unsigned>((y >> (4 * nibble)) & 15);
+        std::uint16_t const entry = table[index];
+        auto & word = digits[nibble >> 3];
+        word = (word << 8) | (entry & 0xff);
+        state = entry >> 8;
+    }
+    return { digits[1], digits[0] };
+}
+
+[[nodiscard]] constexpr auto hilbert_decode(uint128_t const key) noexcept -> point64_t {
+    auto const & table = uint128::details::hilbert_table.decode;
+    std::uint64_t x = 0;
+    std::uint64_t y = 0;
+    unsigned state = 0;
+    for (int byte = 15; byte >= 0; --byte) {
+        std::uint64_t const word = byte >= 8 ? key.upper() : key.lower();
+        std::uint16_t const entry = table[(state << 8) | static_cast<unsigned>((word >> (8 * (byte & 7))) & 0xff)];
+        x = (x << 4) | ((entry >> 4) & 15);
+        y = (y << 4) | (entry & 15);
+        state = entry >> 8;
+    }
+    return { x, y };
+}
+
+namespace uint128::details {
+
+inline void morton_encode_scalar(std::uint64_t const * const xs, std::uint64_t const * const ys, uint128_t * const keys, std::size_t const count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        keys[i] = ::morton_encode(xs[i], ys[i]);
+    }
+}
+
+inline void morton_decode_scalar(uint128_t const * const keys, std::uint64_t * const xs, std::uint64_t * const ys, std::size_t const count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const [x, y] = ::morton_decode(keys[i]);
+        xs[i] = x;
+        ys[i] = y;
+    }
+}
+
+#if defined(UINT128_MORTON_X86_DISPATCH)
+__attribute__((target("bmi2"))) inline void morton_encode_bmi2(std::uint64_t const * const xs, std::uint64_t const * const ys, uint128_t * const keys, std::size_t const count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t const x = xs[i];
+        std::uint64_t const y = ys[i];
+        keys[i] = { _pdep_u64(x >> 32, even_bits64) | _pdep_u64(y >> 32, odd_bits64), _pdep_u64(x, even_bits64) | _pdep_u64(y, odd_bits64) };
+    }
+}
+
+__attribute__((target("bmi2"))) inline void morton_decode_bmi2(uint128_t const * const keys, std::uint64_t * const xs, std::uint64_t * const ys, std::size_t const count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t const upper = keys[i].upper();
+        std::uint64_t const lower = keys[i].lower();
+        xs[i] = _pext_u64(lower, even_bits64) | (_pext_u64(upper, even_bits64) << 32);
+        ys[i] = _pext_u64(lower, odd_bits64) | (_pext_u64(upper, odd_bits64) << 32);
+    }
+}
+
+// BMI2 is there but pdep / pext take tens of cycles (AMD families 15h and 17h).
+inline auto has_fast_bmi2() noexcept -> bool {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2") && !__builtin_cpu_is("amdfam15h") && !__builtin_cpu_is("amdfam17h");
+}
+#endif
+
+using morton_encode_kernel = void (*)(std::uint64_t const *, std::uint64_t const *, uint128_t *, std::size_t) noexcept;
+using morton_decode_kernel = void (*)(uint128_t const *, std::uint64_t *, std::uint64_t *, std::size_t) noexcept;
+
+inline auto select_morton_encode() noexcept -> morton_encode_kernel {
+#if defined(UINT128_MORTON_X86_DISPATCH)
+    if (has_fast_bmi2()) {
+        return morton_encode_bmi2;
+    }
+#endif
+    return morton_encode_scalar;
+}
+
+inline auto select_morton_decode() noexcept -> morton_decode_kernel {
+#if defined(UINT128_MORTON_X86_DISPATCH)
+    if (has_fast_bmi2()) {
+        return morton_decode_bmi2;
+    }
+#endif
+    return morton_decode_scalar;
+}
+
+}
+
+// keys[i] = morton_encode(xs[i], ys[i]); `ys` and `keys` must be at least as long as `xs`.
+inline void morton_encode(std::span<std::uint64_t const> const xs, std::span<std::uint64_t const> const ys, std::span<uint128_t> const keys) noexcept {
+    assert(ys.size() >= xs.size() && keys.size() >= xs.size());
+    static uint128::details::morton_encode_kernel const kernel = uint128::details::select_morton_encode();
+    kernel(xs.data(), ys.data(), keys.data(), xs.size());
+}
+
+// {xs[i], ys[i]} = morton_decode(keys[i]); `xs` and `ys` must be at least as long as `keys`.
+inline void morton_decode(std::span<uint128_t const> const keys, std::span<std::uint64_t> const xs, std::span<std::uint64_t> const ys) noexcept {
+    assert(xs.size() >= keys.size() && ys.size() >= keys.size());
+    static uint128::details::morton_decode_kernel const kernel = uint128::details::select_morton_decode();
+    kernel(keys.data(), xs.data(), ys.data(), keys.size());
+}
+
+#endif
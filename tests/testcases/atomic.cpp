@@ -0,0 +1,128 @@
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "uint128_atomic.h"
+
+namespace {
+
+constexpr uint128_t max_value{ 0xffffffffffffffffULL, 0xffffffffffffffffULL };
+
+}
+
+TEST(Atomic, operations) {
+    atomic_uint128 atomic{ { 1, 2 } };
+    EXPECT_EQ(atomic.load(), uint128_t(1, 2));
+
+    atomic.store(max_value);
+    EXPECT_EQ(atomic.load(), max_value);
+    EXPECT_EQ(atomic.exchange(5), max_value);
+    EXPECT_EQ(static_cast<uint128_t>(atomic), 5);
+
+    // carries and borrows cross the 64-bit halves
+    atomic = std::numeric_limits<uint64_t>::max();
+    EXPECT_EQ(atomic.fetch_add(1), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(atomic.load(), uint128_t(1, 0));
+    EXPECT_EQ(atomic.fetch_sub(1), uint128_t(1, 0));
+    EXPECT_EQ(atomic.load(), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(atomic += max_value, std::numeric_limits<uint64_t>::max() - 1);
+    EXPECT_EQ(atomic.fetch_add(1), std::numeric_limits<uint64_t>::max() - 1);
+    EXPECT_EQ(++atomic, uint128_t(1, 0));
+    EXPECT_EQ(atomic.load(), uint128_t(1, 0));
+    EXPECT_EQ(--atomic, std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(atomic--, std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(atomic.load(), std::numeric_limits<uint64_t>::max() - 1);
+    EXPECT_EQ(atomic++, std::numeric_limits<uint64_t>::max() - 1);
+    EXPECT_EQ(atomic -= max_value, uint128_t(1, 0));
+    static_cast<void>(atomic -= 1);
+    EXPECT_EQ(atomic.load(), std::numeric_limits<uint64_t>::max());
+
+    atomic = uint128_t(0xf0, 0xf0);
+    EXPECT_EQ(atomic.fetch_or(uint128_t(0x0f, 0)), uint128_t(0xf0, 0xf0));
+    EXPECT_EQ(atomic.fetch_and(uint128_t(0x3c, 0xff)), uint128_t(0xff, 0xf0));
+    EXPECT_EQ(atomic.fetch_xor(uint128_t(0xff, 0xff)), uint128_t(0x3c, 0xf0));
+    EXPECT_EQ(atomic.load(), uint128_t(0xc3, 0x0f));
+    EXPECT_EQ(atomic |= 0xf0, uint128_t(0xc3, 0xff));
+    EXPECT_EQ(atomic.load(), uint128_t(0xc3, 0xff));
+    EXPECT_EQ(atomic &= uint128_t(0xff, 0), uint128_t(0xc3, 0));
+    EXPECT_EQ(atomic.load(), uint128_t(0xc3, 0));
+    EXPECT_EQ(atomic ^= uint128_t(0xc3, 1), 1);
+    EXPECT_EQ(atomic.load(), 1);
+
+    atomic_uint128 const zero;
+    EXPECT_EQ(zero.load(), 0);
+    EXPECT_EQ(zero.is_lock_free(), atomic_uint128::is_always_lock_free);
+}
+
+TEST(Atomic, compare_exchange) {
+    atomic_uint128 atomic{ { 1, 2 } };
+
+    // the halves are compared together
+    uint128_t expected{ 1, 3 };
+    EXPECT_FALSE(atomic.compare_exchange_strong(expected, 7));
+    EXPECT_EQ(expected, uint128_t(1, 2));
+    expected = { 0, 2 };
+    EXPECT_FALSE(atomic.compare_exchange_weak(expected, 7));
+    EXPECT_EQ(expected, uint128_t(1, 2));
+
+    EXPECT_TRUE(atomic.compare_exchange_strong(expected, max_value));
+    EXPECT_EQ(expected, uint128_t(1, 2));
+    EXPECT_EQ(atomic.load(), max_value);
+
+    expected = max_value;
+    EXPECT_TRUE(atomic.compare_exchange_weak(expected, 0, std::memory_order_acq_rel, std::memory_order_acquire));
+    EXPECT_EQ(atomic.load(), 0);
+}
+
+TEST(Atomic, locked_fallback) {
+    alignas(16) std::uint64_t words[2]{ 2, 1 };
+    std::uint64_t expected[2]{ 2, 0 };
+    std::uint64_t const desired[2]{ 3, 4 };
+    EXPECT_FALSE(uint128::details::cas128_locked(words, expected, desired));
+    EXPECT_EQ(expected[0], 2);
+    EXPECT_EQ(expected[1], 1);
+    EXPECT_TRUE(uint128::details::cas128_locked(words, expected, desired));
+    EXPECT_EQ(words[0], 3);
+    EXPECT_EQ(words[1], 4);
+}
+
+TEST(Atomic, contention) {
+    constexpr std::size_t thread_count = 4;
+    constexpr std::size_t increments = 20000;
+
+    // start below 2^64 so that the increments carry into the upper half
+    uint128_t const start = std::numeric_limits<uint64_t>::max() - increments;
+    atomic_uint128 counter{ start };
+    std::vector<std::vector<uint128_t>> tickets(thread_count);
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            tickets[t].reserve(increments);
+            for (std::size_t i = 0; i < increments; ++i) {
+                tickets[t].push_back(counter.fetch_add(1));
+            }
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter.load(), start + thread_count * increments);
+
+    // every fetch_add saw a distinct value
+    std::vector<bool> seen(thread_count * increments);
+    for (auto const & list : tickets) {
+        for (auto const ticket : list) {
+            ASSERT_GE(ticket, start);
+            auto const index = static_cast<std::size_t>(ticket - start);
+            ASSERT_LT(index, seen.size());
+            EXPECT_FALSE(seen[index]);
+            seen[index] = true;
+        }
+    }
+}
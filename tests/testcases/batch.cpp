@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "uint128_batch.h"
+
+TEST(Batch, parse_column){
+    const std::string text = "0\n1\n18446744073709551616\r\n340282366920938463463374607431768211455\n";
+
+    std::vector<uint128_t> values(8);
+    std::vector<uint64_t> errors(1, ~0ULL);
+    const auto res = parse_column(text, '\n', std::span{ values }, std::span{ errors });
+
+    EXPECT_EQ(res.rows, 4);
+    EXPECT_EQ(res.errors, 0);
+    EXPECT_EQ(res.ptr, text.data() + text.size());
+    EXPECT_EQ(errors[0], 0);
+
+    EXPECT_EQ(values[0], 0);
+    EXPECT_EQ(values[1], 1);
+    EXPECT_EQ(values[2], uint128_t(1, 0));
+    EXPECT_EQ(values[3], uint128_t(0xffffffffffffffffULL, 0xffffffffffffffffULL));
+}
+
+TEST(Batch, parse_column_errors){
+    // empty, invalid character, overflow, sign, valid without trailing delimiter
+    const std::string text = "12,,1x,340282366920938463463374607431768211456,-1,7";
+
+    std::vector<uint128_t> values(8, uint128_t(42));
+    std::vector<uint64_t> errors(1);
+    const auto res = parse_column(text, ',', std::span{ values }, std::span{ errors });
+
+    EXPECT_EQ(res.rows, 6);
+    EXPECT_EQ(res.errors, 4);
+    EXPECT_EQ(res.ptr, text.data() + text.size());
+    EXPECT_EQ(errors[0], 0b011110);
+
+    EXPECT_EQ(values[0], 12);
+    EXPECT_EQ(values[1], 0);
+    EXPECT_EQ(values[2], 0);
+    EXPECT_EQ(values[3], 0);
+    EXPECT_EQ(values[4], 0);
+    EXPECT_EQ(values[5], 7);
+    EXPECT_EQ(values[6], 42);
+}
+
+TEST(Batch, parse_column_hex){
+    const std::string text = "ff;FEDCBA9876543210fedcba9876543210;0;g";
+
+    std::vector<uint128_t> values(4);
+    std::vector<uint64_t> errors(1);
+    const auto res = parse_column(text, ';', std::span{ values }, std::span{ errors }, 16);
+
+    EXPECT_EQ(res.rows, 4);
+    EXPECT_EQ(errors[0], 0b1000);
+    EXPECT_EQ(values[0], 0xff);
+    EXPECT_EQ(values[1], uint128_t(0xfedcba9876543210ULL, 0xfedcba9876543210ULL));
+    EXPECT_EQ(values[2], 0);
+
+    const std::string octal = "777\n8\n";
+    EXPECT_EQ(parse_column(octal, '\n', std::span{ values }, std::span{ errors }, 8).errors, 1);
+    EXPECT_EQ(values[0], 0777);
+}
+
+TEST(Batch, parse_column_leading_zeros){
+    // tokens after the first 8 characters are read in 8-character blocks
+    const std::string text = "00000000,0000000000000000000000000000000000000000340282366920938463463374607431768211455,"
+                             "0000000000000000000000000000000000000001,00000000000000000000000000000000000000001x,123456789";
+
+    std::vector<uint128_t> values(8);
+    std::vector<uint64_t> errors(1);
+    const auto res = parse_column(text, ',', std::span{ values }, std::span{ errors });
+
+    EXPECT_EQ(res.rows, 5);
+    EXPECT_EQ(errors[0], 0b01000);
+    EXPECT_EQ(values[0], 0);
+    EXPECT_EQ(values[1], uint128_t(0xffffffffffffffffULL, 0xffffffffffffffffULL));
+    EXPECT_EQ(values[2], 1);
+    EXPECT_EQ(values[4], 123456789);
+
+    const std::string hex = "0123456789,000000000000000000000000000000000000000000000001,fffffffffffffffffffffffffffffffff";
+    EXPECT_EQ(parse_column(hex, ',', std::span{ values }, std::span{ errors }, 16).errors, 1);
+    EXPECT_EQ(errors[0], 0b100);
+    EXPECT_EQ(values[0], 0x123456789);
+    EXPECT_EQ(values[1], 1);
+}
+
+TEST(Batch, parse_column_many){
+    // long enough to go through the 64 character block scan, with rows across block boundaries
+    std::string text;
+    std::vector<uint128_t> expected;
+    uint128_t value(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+    for (int i = 0; i < 1000; ++i) {
+        value = value * uint128_t(0x9e3779b97f4a7c15ULL) + 1;
+        const uint128_t row = value >> (i % 128);
+        expected.push_back(row);
+        text += row.str() + '\n';
+    }
+
+    std::vector<uint128_t> values;
+    std::vector<uint64_t> errors(16);
+    const auto res = parse_column(text, '\n', std::back_inserter(values), std::span{ errors });
+
+    EXPECT_EQ(res.rows, 1000);
+    EXPECT_EQ(res.errors, 0);
+    EXPECT_EQ(values, expected);
+}
+
+TEST(Batch, parse_column_full){
+    const std::string text = "1\n2\n3\n4\n";
+
+    std::vector<uint128_t> values(2);
+    std::vector<uint64_t> errors(1);
+    auto res = parse_column(text, '\n', std::span{ values }, std::span{ errors });
+
+    EXPECT_EQ(res.rows, 2);
+    EXPECT_EQ(res.ptr, text.data() + 4);
+    EXPECT_EQ(values[1], 2);
+
+    // resume from where the previous call stopped
+    res = parse_column(std::string_view(res.ptr, text.data() + text.size()), '\n', std::span{ values }, std::span{ errors });
+    EXPECT_EQ(res.rows, 2);
+    EXPECT_EQ(res.ptr, text.data() + text.size());
+    EXPECT_EQ(values[0], 3);
+    EXPECT_EQ(values[1], 4);
+
+    // the bitmap limits the rows of the output iterator overload
+    std::vector<uint128_t> unbounded;
+    std::vector<uint64_t> no_errors;
+    res = parse_column(text, '\n', std::back_inserter(unbounded), std::span{ no_errors });
+    EXPECT_EQ(res.rows, 0);
+    EXPECT_EQ(res.ptr, text.data());
+}
+
+TEST(Batch, format_hex_column){
+    const std::vector<uint128_t> values = { uint128_t(0), uint128_t(0xabcULL, 0xdefULL) };
+
+    std::string out(66, '?');
+    const auto res = format_hex_column(values, out, ',', true);
+    EXPECT_EQ(res.ec, std::errc{});
+    EXPECT_EQ(res.ptr, out.data() + out.size());
+    EXPECT_EQ(out, std::string(32, '0') + ",0000000000000ABC0000000000000DEF,");
+
+    // round trip through the parser
+    std::vector<uint128_t> parsed(2);
+    std::vector<uint64_t> errors(1);
+    EXPECT_EQ(parse_column(out, ',', std::span{ parsed }, std::span{ errors }, 16).errors, 0);
+    EXPECT_EQ(parsed, values);
+
+    std::string small(65, '?');
+    EXPECT_EQ(format_hex_column(values, small).ec, std::errc::value_too_large);
+    EXPECT_EQ(small, std::string(65, '?'));
+}
+
+TEST(Batch, hton_ntoh){
+    uint64_t state = 0x0123456789abcdefULL;
+    const auto next = [&] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    // every length up to a few vectors, to cover the tails of each kernel
+    for (std::size_t n = 0; n < 40; ++n) {
+        std::vector<uint128_t> values(n);
+        for (auto & value : values) {
+            value = uint128_t(next(), next());
+        }
+
+        std::vector<std::byte> wire(16 * n);
+        hton(values, wire);
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto expected = values[i].to_bytes();
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), wire.begin() + static_cast<std::ptrdiff_t>(16 * i))) << n << " " << i;
+        }
+
+        std::vector<uint128_t> back(n);
+        ntoh(wire, back);
+        EXPECT_EQ(back, values) << n;
+
+        std::vector<uint128_t> in_place = values;
+        hton(in_place);
+        EXPECT_EQ(std::memcmp(in_place.data(), wire.data(), wire.size()), 0) << n;
+        ntoh(in_place);
+        EXPECT_EQ(in_place, values) << n;
+    }
+}
+
+TEST(Batch, byteswap128_kernels){
+    std::vector<uint128::details::byteswap128_kernel> kernels = { uint128::details::byteswap128_scalar };
+#if defined(UINT128_BATCH_X86_DISPATCH)
+    if (__builtin_cpu_supports("ssse3")) {
+        kernels.push_back(uint128::details::byteswap128_ssse3);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back(uint128::details::byteswap128_avx2);
+    }
+    if (__builtin_cpu_supports("avx512bw")) {
+        kernels.push_back(uint128::details::byteswap128_avx512);
+    }
+#endif
+
+    std::vector<std::byte> in(16 * 11);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<std::byte>(i);
+    }
+
+    for (const auto kernel : kernels) {
+        for (std::size_t n = 0; n <= 11; ++n) {
+            std::vector<std::byte> out(in.size(), std::byte{ 0xee });
+            kernel(in.data(), out.data(), n);
+            for (std::size_t i = 0; i < out.size(); ++i) {
+                const auto expected = i < 16 * n ? static_cast<std::byte>((i & ~std::size_t{ 15 }) + 15 - (i & 15)) : std::byte{ 0xee };
+                EXPECT_EQ(out[i], expected) << n << " " << i;
+            }
+        }
+    }
+}
+
+namespace {
+
+// bit j of row i, one bit at a time
+auto transpose_reference(std::vector<uint128_t> const & in) -> std::vector<uint128_t> {
+    std::vector<uint128_t> out(128);
+    for (unsigned i = 0; i < 128; ++i) {
+        for (unsigned j = 0; j < 128; ++j) {
+            if (((in[i] >> j) & 1) != 0) {
+                out[j] |= uint128_t(1) << i;
+            }
+        }
+    }
+    return out;
+}
+
+auto random_matrix(uint64_t seed) -> std::vector<uint128_t> {
+    std::vector<uint128_t> matrix(128);
+    for (auto & row : matrix) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        const uint64_t upper = seed;
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        row = uint128_t(upper, seed);
+    }
+    return matrix;
+}
+
+}
+
+TEST(Batch, transpose){
+    // identity and a single bit
+    std::vector<uint128_t> matrix(128);
+    for (unsigned i = 0; i < 128; ++i) {
+        matrix[i] = uint128_t(1) << i;
+    }
+    transpose(std::span<uint128_t, 128>{ matrix });
+    for (unsigned i = 0; i < 128; ++i) {
+        EXPECT_EQ(matrix[i], uint128_t(1) << i) << i;
+    }
+
+    std::vector<uint128_t> single(128);
+    single[3] = uint128_t(1) << 100;
+    transpose(std::span<uint128_t, 128>{ single });
+    for (unsigned i = 0; i < 128; ++i) {
+        EXPECT_EQ(single[i], i == 100 ? uint128_t(1) << 3 : uint128_t(0)) << i;
+    }
+
+    for (uint64_t seed = 1; seed <= 4; ++seed) {
+        const auto in = random_matrix(seed * 0x9e3779b97f4a7c15ULL);
+        std::vector<uint128_t> out(128);
+        transpose(std::span<uint128_t const, 128>{ in }, std::span<uint128_t, 128>{ out });
+        EXPECT_EQ(out, transpose_reference(in));
+
+        // in place, and back
+        transpose(std::span<uint128_t, 128>{ out });
+        EXPECT_EQ(out, in);
+    }
+}
+
+TEST(Batch, transpose128_kernels){
+    std::vector<uint128::details::transpose128_kernel> kernels = { uint128::details::transpose128_scalar };
+#if defined(__SSE2__) || defined(_M_X64)
+    kernels.push_back(uint128::details::transpose128_sse2);
+#endif
+#if defined(UINT128_BATCH_X86_DISPATCH)
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back(uint128::details::transpose128_avx2);
+    }
+    if (__builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("gfni")) {
+        kernels.push_back(uint128::details::transpose128_gfni);
+    }
+#endif
+
+    const auto in = random_matrix(0x0123456789abcdefULL);
+    const auto expected = transpose_reference(in);
+    for (std::size_t k = 0; k < kernels.size(); ++k) {
+        std::vector<uint128_t> out(128);
+        kernels[k](in.data(), out.data());
+        EXPECT_EQ(out, expected) << k;
+
+        std::vector<uint128_t> in_place = in;
+        kernels[k](in_place.data(), in_place.data());
+        EXPECT_EQ(in_place, expected) << k;
+    }
+}
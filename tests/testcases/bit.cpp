@@ -0,0 +1,190 @@
+#include <climits>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "uint128_bit.h"
+
+namespace {
+
+const uint128_t val(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+
+template <unsigned... N>
+void check_constant_shifts(uint128_t const value, std::integer_sequence<unsigned, N...>) {
+    bool const left[] = { (shl<N>(value) == (value << N))... };
+    bool const right[] = { (shr<N>(value) == (value >> N))... };
+    for (unsigned n = 0; n < sizeof...(N); ++n) {
+        EXPECT_TRUE(left[n]) << n;
+        EXPECT_TRUE(right[n]) << n;
+    }
+}
+
+}
+
+TEST(Bit, rotate){
+    EXPECT_EQ(rotl(val, 0), val);
+    EXPECT_EQ(rotl(val, 64), uint128_t(0xfedcba9876543210ULL, 0x0123456789abcdefULL));
+    EXPECT_EQ(rotl(val, 4), uint128_t(0x123456789abcdeffULL, 0xedcba98765432100ULL));
+    EXPECT_EQ(rotr(val, 4), uint128_t(0x00123456789abcdeULL, 0xffedcba987654321ULL));
+    EXPECT_EQ(rotl(uint128_t(0x8000000000000000ULL, 0), 1), 1);
+    EXPECT_EQ(rotr(uint128_t(1), 1), uint128_t(0x8000000000000000ULL, 0));
+
+    for (int s = -300; s <= 300; ++s) {
+        int const r = ((s % 128) + 128) % 128;
+        uint128_t const expected = r ? (val << r) | (val >> (128 - r)) : val;
+        EXPECT_EQ(rotl(val, s), expected) << s;
+        EXPECT_EQ(rotr(val, -s), expected) << s;
+    }
+    EXPECT_EQ(rotl(val, INT_MIN), val);
+    EXPECT_EQ(rotr(val, INT_MIN), val);
+
+    static_assert(rotl(uint128_t(1), 127) == uint128_t(0x8000000000000000ULL, 0));
+    static_assert(rotr(uint128_t(1), 65) == uint128_t(0x8000000000000000ULL));
+}
+
+TEST(Bit, funnel_shift){
+    const uint128_t hi(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+    const uint128_t lo(0xf0e1d2c3b4a59687ULL, 0x78695a4b3c2d1e0fULL);
+
+    EXPECT_EQ(funnel_shift_left(hi, lo, 0), hi);
+    EXPECT_EQ(funnel_shift_right(hi, lo, 0), lo);
+    EXPECT_EQ(funnel_shift_left(hi, lo, 64), uint128_t(0xfedcba9876543210ULL, 0xf0e1d2c3b4a59687ULL));
+    EXPECT_EQ(funnel_shift_right(hi, lo, 64), uint128_t(0xfedcba9876543210ULL, 0xf0e1d2c3b4a59687ULL));
+
+    for (unsigned n = 0; n < 300; ++n) {
+        unsigned const r = n % 128;
+        EXPECT_EQ(funnel_shift_left(hi, lo, n), r ? (hi << r) | (lo >> (128 - r)) : hi) << n;
+        EXPECT_EQ(funnel_shift_right(hi, lo, n), r ? (lo >> r) | (hi << (128 - r)) : lo) << n;
+    }
+
+    // rotates are funnel shifts of a value with itself
+    EXPECT_EQ(funnel_shift_left(val, val, 37), rotl(val, 37));
+    EXPECT_EQ(funnel_shift_right(val, val, 37), rotr(val, 37));
+
+    static_assert(funnel_shift_left(uint128_t(1), uint128_t(0x8000000000000000ULL, 0), 1) == 3);
+}
+
+TEST(Bit, constant_shifts){
+    check_constant_shifts(val, std::make_integer_sequence<unsigned, 128>{});
+
+    static_assert(shl<64>(uint128_t(1)) == uint128_t(1, 0));
+    static_assert(shr<127>(uint128_t(0x8000000000000000ULL, 0)) == 1);
+}
+
+TEST(Bit, shift_counts){
+    // counts with the upper word set, or beyond 127, shift everything out
+    for (uint64_t const shift : { 128ULL, 129ULL, 192ULL, 1ULL << 32, 1ULL << 63, ~0ULL }) {
+        EXPECT_EQ(val << shift, 0) << shift;
+        EXPECT_EQ(val >> shift, 0) << shift;
+    }
+    EXPECT_EQ(val << uint128_t(1, 3), 0);
+    EXPECT_EQ(val >> uint128_t(1, 3), 0);
+    EXPECT_EQ(val << int8_t{ -128 }, 0);
+    EXPECT_EQ(val >> int8_t{ -128 }, 0);
+}
+
+TEST(Bit, counts){
+    const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+
+    EXPECT_EQ(popcount(uint128_t(0)), 0);
+    EXPECT_EQ(popcount(max), 128);
+    EXPECT_EQ(popcount(val), 64);
+
+    EXPECT_EQ(countl_zero(uint128_t(0)), 128);
+    EXPECT_EQ(countl_zero(uint128_t(1)), 127);
+    EXPECT_EQ(countl_zero(uint128_t(1, 0)), 63);
+    EXPECT_EQ(countl_zero(max), 0);
+    EXPECT_EQ(countr_zero(uint128_t(0)), 128);
+    EXPECT_EQ(countr_zero(uint128_t(1, 0)), 64);
+    EXPECT_EQ(countr_zero(uint128_t(0x8000000000000000ULL, 0)), 127);
+    EXPECT_EQ(countl_one(max), 128);
+    EXPECT_EQ(countl_one(uint128_t(0xffffffffffffffffULL, 0xf000000000000000ULL)), 68);
+    EXPECT_EQ(countr_one(uint128_t(0xffffffffffffffffULL)), 64);
+    EXPECT_EQ(countr_one(uint128_t(1, 0xffffffffffffffffULL)), 65);
+
+    EXPECT_EQ(bit_width(uint128_t(0)), 0);
+    EXPECT_EQ(bit_width(val), val.bits());
+    EXPECT_EQ(bit_width(max), 128);
+
+    static_assert(popcount(uint128_t(0x0123456789abcdefULL, 0xfedcba9876543210ULL)) == 64);
+    static_assert(countl_zero(uint128_t(1)) == 127);
+    static_assert(countr_zero(uint128_t(1, 0)) == 64);
+}
+
+TEST(Bit, powers_of_two){
+    const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+
+    EXPECT_FALSE(has_single_bit(uint128_t(0)));
+    EXPECT_TRUE(has_single_bit(uint128_t(1, 0)));
+    EXPECT_FALSE(has_single_bit(uint128_t(1, 1)));
+
+    EXPECT_EQ(bit_floor(uint128_t(0)), 0);
+    EXPECT_EQ(bit_floor(uint128_t(1)), 1);
+    EXPECT_EQ(bit_floor(val), uint128_t(0x0100000000000000ULL, 0));
+    EXPECT_EQ(bit_floor(max), uint128_t(0x8000000000000000ULL, 0));
+
+    EXPECT_EQ(bit_ceil(uint128_t(0)), 1);
+    EXPECT_EQ(bit_ceil(uint128_t(1)), 1);
+    EXPECT_EQ(bit_ceil(uint128_t(3)), 4);
+    EXPECT_EQ(bit_ceil(uint128_t(1, 0)), uint128_t(1, 0));
+    EXPECT_EQ(bit_ceil(uint128_t(1, 1)), uint128_t(2, 0));
+    EXPECT_EQ(bit_ceil(uint128_t(0x8000000000000000ULL, 0)), uint128_t(0x8000000000000000ULL, 0));
+    EXPECT_EQ(bit_ceil(uint128_t(0x8000000000000000ULL, 1)), 0);
+
+    static_assert(bit_ceil(uint128_t(0xffffffffffffffffULL)) == uint128_t(1, 0));
+}
+
+TEST(Bit, reverse){
+    EXPECT_EQ(byteswap(val), uint128_t(0x1032547698badcfeULL, 0xefcdab8967452301ULL));
+    EXPECT_EQ(byteswap(byteswap(val)), val);
+    EXPECT_EQ(bit_reverse(uint128_t(1)), uint128_t(0x8000000000000000ULL, 0));
+    EXPECT_EQ(bit_reverse(uint128_t(0x0123456789abcdefULL, 0)), uint128_t(0xf7b3d591e6a2c480ULL));
+    EXPECT_EQ(bit_reverse(bit_reverse(val)), val);
+
+    for (int i = 0; i < 128; ++i) {
+        EXPECT_EQ(bit_reverse(uint128_t(1) << i), uint128_t(1) << (127 - i)) << i;
+    }
+
+    static_assert(byteswap(uint128_t(0x0102)) == uint128_t(0x0201000000000000ULL, 0));
+    static_assert(bit_reverse(uint128_t(0x8000000000000000ULL, 0)) == 1);
+}
+
+TEST(Bit, rank_select){
+    // reference: walk the bits
+    auto check = [](uint128_t const value) {
+        int count = 0;
+        for (unsigned i = 0; i < 128; ++i) {
+            EXPECT_EQ(rank(value, i), count) << value << " " << i;
+            if (((value >> i) & 1) != 0) {
+                EXPECT_EQ(select(value, static_cast<unsigned>(count)), static_cast<int>(i)) << value << " " << count;
+                ++count;
+            }
+        }
+        EXPECT_EQ(rank(value, 128), count);
+        EXPECT_EQ(select(value, static_cast<unsigned>(count)), 128);
+        EXPECT_EQ(select(value, 1000), 128);
+    };
+
+    check(uint128_t(0));
+    check(uint128_t(1));
+    check(uint128_t(0x8000000000000000ULL, 0));
+    check(uint128_t(0xffffffffffffffffULL, 0xffffffffffffffffULL));
+    check(val);
+    check(uint128_t(0x00000000000000f0ULL, 0x0f00000000000000ULL));
+
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    auto next = [&state] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int i = 0; i < 200; ++i) {
+        // sparse and dense words
+        check(uint128_t(next() & next() & next(), next() | next()));
+    }
+
+    static_assert(select(uint128_t(0x0123456789abcdefULL, 0xfedcba9876543210ULL), 0) == 4);
+    static_assert(select(uint128_t(1, 0), 0) == 64);
+    static_assert(rank(uint128_t(0x0123456789abcdefULL, 0xfedcba9876543210ULL), 64) == 32);
+}
@@ -0,0 +1,251 @@
+#include <bit>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "uint128.h"
+
+namespace {
+
+auto to_string(uint128_t const value, int const base = 10) -> std::string {
+    char buffer[128];
+    auto const [ptr, ec] = to_chars(std::begin(buffer), std::end(buffer), value, base);
+    EXPECT_EQ(ec, std::errc{});
+    return { std::begin(buffer), ptr };
+}
+
+const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+
+}
+
+TEST(Function, to_chars){
+    EXPECT_EQ(to_string(uint128_t(0)), "0");
+    EXPECT_EQ(to_string(uint128_t(9)), "9");
+    EXPECT_EQ(to_string(uint128_t(10)), "10");
+    EXPECT_EQ(to_string(uint128_t(0xffffffffffffffffULL)), "18446744073709551615");
+    EXPECT_EQ(to_string(uint128_t(1, 0)), "18446744073709551616");
+    EXPECT_EQ(to_string(uint128_t(0, 10000000000000000000ULL)), "10000000000000000000");
+    EXPECT_EQ(to_string(uint128_t(0xfedcba9876543210ULL, 0xfedcba9876543210ULL)), "338770000845734292534325025077361652240");
+    EXPECT_EQ(to_string(max), "340282366920938463463374607431768211455");
+
+    EXPECT_EQ(to_string(max, 16), "ffffffffffffffffffffffffffffffff");
+    EXPECT_EQ(to_string(max, 2), std::string(128, '1'));
+    EXPECT_EQ(to_string(max, 8), "3777777777777777777777777777777777777777777");
+    EXPECT_EQ(to_string(max, 36), "f5lxx1zz5pnorynqglhzmsp33");
+    EXPECT_EQ(to_string(uint128_t(35), 36), "z");
+    EXPECT_EQ(to_string(uint128_t(1, 0), 3), "11112220022122120101211020120210210211221");
+}
+
+TEST(Function, to_chars_too_small){
+    char buffer[19];
+    const auto res = to_chars(std::begin(buffer), std::end(buffer), uint128_t(0, 10000000000000000000ULL));
+    EXPECT_EQ(res.ec, std::errc::value_too_large);
+    EXPECT_EQ(res.ptr, std::end(buffer));
+
+    const auto empty = to_chars(std::begin(buffer), std::begin(buffer), uint128_t(0));
+    EXPECT_EQ(empty.ec, std::errc::value_too_large);
+}
+
+TEST(Function, from_chars){
+    const std::string_view text = "340282366920938463463374607431768211455 tail";
+    uint128_t value;
+    const auto res = from_chars(text.data(), text.data() + text.size(), value);
+    EXPECT_EQ(res.ec, std::errc{});
+    EXPECT_EQ(res.ptr, text.data() + 39);
+    EXPECT_EQ(value, max);
+
+    for (int base = 2; base <= 36; ++base) {
+        for (const uint128_t original : { uint128_t(0), uint128_t(1), uint128_t(0xfedcba9876543210ULL, 0x0123456789abcdefULL), max }) {
+            const std::string digits = to_string(original, base);
+            uint128_t parsed;
+            const auto r = from_chars(digits.data(), digits.data() + digits.size(), parsed, base);
+            EXPECT_EQ(r.ec, std::errc{});
+            EXPECT_EQ(r.ptr, digits.data() + digits.size());
+            EXPECT_EQ(parsed, original);
+        }
+    }
+
+    const std::string_view upper = "FEDCBA9876543210fedcba9876543210";
+    EXPECT_EQ(from_chars(upper.data(), upper.data() + upper.size(), value, 16).ec, std::errc{});
+    EXPECT_EQ(value, uint128_t(0xfedcba9876543210ULL, 0xfedcba9876543210ULL));
+}
+
+TEST(Function, from_chars_errors){
+    uint128_t value(42);
+
+    const std::string_view invalid = "-1";
+    auto res = from_chars(invalid.data(), invalid.data() + invalid.size(), value);
+    EXPECT_EQ(res.ec, std::errc::invalid_argument);
+    EXPECT_EQ(res.ptr, invalid.data());
+    EXPECT_EQ(value, 42);
+
+    const std::string_view empty;
+    EXPECT_EQ(from_chars(empty.data(), empty.data(), value).ec, std::errc::invalid_argument);
+
+    // 2^128
+    const std::string_view overflow = "340282366920938463463374607431768211456,";
+    res = from_chars(overflow.data(), overflow.data() + overflow.size(), value);
+    EXPECT_EQ(res.ec, std::errc::result_out_of_range);
+    EXPECT_EQ(res.ptr, overflow.data() + 39);
+    EXPECT_EQ(value, 42);
+
+    const std::string_view long_hex = "100000000000000000000000000000000";
+    res = from_chars(long_hex.data(), long_hex.data() + long_hex.size(), value, 16);
+    EXPECT_EQ(res.ec, std::errc::result_out_of_range);
+    EXPECT_EQ(res.ptr, long_hex.data() + long_hex.size());
+
+    // leading zeros do not overflow
+    const std::string_view zeros = "0000000000000000000000000000000000000000000000000001";
+    res = from_chars(zeros.data(), zeros.data() + zeros.size(), value);
+    EXPECT_EQ(res.ec, std::errc{});
+    EXPECT_EQ(value, 1);
+}
+
+TEST(Function, charconv_constexpr){
+    constexpr auto roundtrip = [] {
+        char buffer[40]{};
+        const uint128_t original(0xfedcba9876543210ULL, 0x0123456789abcdefULL);
+        const auto end = to_chars(std::begin(buffer), std::end(buffer), original).ptr;
+        uint128_t parsed;
+        from_chars(std::begin(buffer), end, parsed);
+        return parsed == original;
+    };
+    static_assert(roundtrip());
+}
+
+TEST(Function, from_chars_stops_at_invalid){
+    // every length and every position of the first invalid character, so that
+    // both the 8 / 16 character blocks and the one-at-a-time tail are covered
+    const std::string dec_digits = "340282366920938463463374607431768211455";
+    const std::string hex_digits = "fEdCbA9876543210FeDcBa9876543210";
+
+    for (const auto & [digits, base] : { std::pair{ dec_digits, 10 }, std::pair{ hex_digits, 16 } }) {
+        for (std::size_t len = 1; len <= digits.size(); ++len) {
+            for (const char stop : { ' ', '/', ':', '@', 'G', 'g', '`', '\x80', '\xff' }) {
+                std::string text = digits.substr(0, len) + stop + "123456789abcdef0";
+                uint128_t value;
+                const auto res = from_chars(text.data(), text.data() + text.size(), value, base);
+                ASSERT_EQ(res.ec, std::errc{}) << text;
+                EXPECT_EQ(res.ptr, text.data() + len) << text;
+                EXPECT_EQ(value, uint128_t(digits.substr(0, len), static_cast<uint8_t>(base))) << text;
+                EXPECT_EQ(to_string(value, base), [&] {
+                    std::string expected = digits.substr(0, len);
+                    for (auto & c : expected) {
+                        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                    }
+                    expected.erase(0, std::min(expected.find_first_not_of('0'), expected.size() - 1));
+                    return expected;
+                }()) << text;
+            }
+        }
+    }
+}
+
+TEST(Function, from_chars_hex_characters){
+    // each byte value in each position of an 8 character block
+    for (int c = 0; c < 256; ++c) {
+        const bool is_hex = std::isxdigit(c) != 0;
+        for (std::size_t pos = 0; pos < 8; ++pos) {
+            std::string text = "00000000";
+            text[pos] = static_cast<char>(c);
+            uint128_t value;
+            const auto res = from_chars(text.data(), text.data() + text.size(), value, 16);
+            EXPECT_EQ(res.ptr, text.data() + (is_hex ? 8 : pos)) << c;
+            if (is_hex) {
+                EXPECT_EQ(value, uint128_t(std::stoul(std::string(1, static_cast<char>(c)), nullptr, 16)) << (4 * (7 - pos))) << c;
+            }
+        }
+    }
+}
+
+TEST(Function, to_chars_power_of_two){
+    // reference: peel off digits with shifts of the value itself
+    const auto reference = [](uint128_t value, const int base) {
+        const int shift = std::countr_zero(static_cast<unsigned>(base));
+        std::string digits;
+        do {
+            digits.insert(digits.begin(), "0123456789abcdefghijklmnopqrstuv"[(value & (base - 1)).lower()]);
+            value >>= shift;
+        } while (value);
+        return digits;
+    };
+
+    uint64_t state = 0x0123456789abcdefULL;
+    const auto next = [&] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    for (const int base : { 2, 4, 8, 16, 32 }) {
+        EXPECT_EQ(to_string(uint128_t(0), base), "0");
+        EXPECT_EQ(to_string(max, base), reference(max, base)) << base;
+        for (int bit = 0; bit < 128; ++bit) {
+            const uint128_t value = uint128_1 << bit;
+            EXPECT_EQ(to_string(value, base), reference(value, base)) << base << " " << bit;
+            EXPECT_EQ(to_string(value - 1, base), reference(value - 1, base)) << base << " " << bit;
+        }
+        for (int i = 0; i < 1000; ++i) {
+            const uint128_t value = uint128_t(next(), next()) >> (next() & 127);
+            EXPECT_EQ(to_string(value, base), reference(value, base)) << base;
+        }
+    }
+
+    EXPECT_EQ(to_string(max, 32), "7vvvvvvvvvvvvvvvvvvvvvvvvv");
+    EXPECT_EQ(uint128_t(1, 5).str(2), "1" + std::string(61, '0') + "101");
+    EXPECT_EQ(uint128_t(0xff).str(8, 5), "00377");
+
+    static_assert([] {
+        char buffer[128]{};
+        auto const ptr = to_chars(std::begin(buffer), std::end(buffer), uint128_t(0x0123456789abcdefULL, 0), 8).ptr;
+        return std::string_view(buffer, ptr) == "11064254742325715736000000000000000000000";
+    }());
+}
+
+TEST(Function, to_hex_chars){
+    char buffer[40];
+    const auto hex = [&](const uint128_t value, const std::size_t width, const bool uppercase) {
+        const auto [ptr, ec] = to_hex_chars(std::begin(buffer), std::end(buffer), value, width, uppercase);
+        EXPECT_EQ(ec, std::errc{});
+        return std::string(std::begin(buffer), ptr);
+    };
+
+    EXPECT_EQ(hex(uint128_t(0), 32, false), std::string(32, '0'));
+    EXPECT_EQ(hex(uint128_t(0), 0, false), "0");
+    EXPECT_EQ(hex(uint128_t(0xabc), 1, false), "abc");
+    EXPECT_EQ(hex(uint128_t(0xabc), 5, true), "00ABC");
+    EXPECT_EQ(hex(uint128_t(0xfedcba9876543210ULL, 0x0123456789abcdefULL), 32, false), "fedcba98765432100123456789abcdef");
+    EXPECT_EQ(hex(uint128_t(0xfedcba9876543210ULL, 0x0123456789abcdefULL), 32, true), "FEDCBA98765432100123456789ABCDEF");
+    EXPECT_EQ(hex(max, 40, false), "00000000" + std::string(32, 'f'));
+
+    EXPECT_EQ(to_hex_chars(buffer, buffer + 31, max).ec, std::errc::value_too_large);
+    EXPECT_EQ(to_hex_chars(buffer, buffer + 3, uint128_t(0xabc), 4).ec, std::errc::value_too_large);
+
+    // every nibble value in every position
+    for (std::size_t pos = 0; pos < 32; ++pos) {
+        for (unsigned nibble = 0; nibble < 16; ++nibble) {
+            const uint128_t value = uint128_t(nibble) << (4 * (31 - pos));
+            std::string expected(32, '0');
+            expected[pos] = "0123456789abcdef"[nibble];
+            EXPECT_EQ(hex(value, 32, false), expected);
+            EXPECT_EQ(to_string(value, 16), expected.substr(std::min(expected.find_first_not_of('0'), std::size_t{ 31 })));
+        }
+    }
+}
+
+TEST(Function, to_hex_chars_constexpr){
+    static_assert([] {
+        char buffer[32]{};
+        to_hex_chars(std::begin(buffer), std::end(buffer), uint128_t(0x0123456789abcdefULL, 0xfedcba9876543210ULL), 32, true);
+        return std::string_view(buffer, 32) == "0123456789ABCDEFFEDCBA9876543210";
+    }());
+}
+
+TEST(Constructor, String_constexpr){
+    constexpr uint128_t hex("fedcba9876543210fedcba9876543210", 32, 16);
+    constexpr uint128_t dec("338770000845734292534325025077361652240", 39, 10);
+    static_assert(hex == uint128_t(0xfedcba9876543210ULL, 0xfedcba9876543210ULL));
+    static_assert(dec == hex);
+}
@@ -0,0 +1,217 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "uint128_codec.h"
+
+namespace {
+
+auto bytes(std::initializer_list<unsigned> const list) -> std::vector<std::byte> {
+    std::vector<std::byte> out;
+    for (auto const b : list) {
+        out.push_back(static_cast<std::byte>(b));
+    }
+    return out;
+}
+
+auto leb128(uint128_t const value) -> std::vector<std::byte> {
+    std::array<std::byte, leb128_max_size> buffer{};
+    auto const [ptr, ec] = encode_leb128(buffer.data(), buffer.data() + buffer.size(), value);
+    EXPECT_EQ(ec, std::errc{});
+    return { buffer.data(), ptr };
+}
+
+// reference encoder, one group at a time
+auto leb128_reference(uint128_t value) -> std::vector<std::byte> {
+    std::vector<std::byte> out;
+    do {
+        auto byte = static_cast<unsigned>((value & 0x7f).lower());
+        value >>= 7;
+        if (value) {
+            byte |= 0x80;
+        }
+        out.push_back(static_cast<std::byte>(byte));
+    } while (value);
+    return out;
+}
+
+const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+
+}
+
+TEST(Codec, leb128){
+    EXPECT_EQ(leb128(uint128_t(0)), bytes({ 0x00 }));
+    EXPECT_EQ(leb128(uint128_t(127)), bytes({ 0x7f }));
+    EXPECT_EQ(leb128(uint128_t(128)), bytes({ 0x80, 0x01 }));
+    EXPECT_EQ(leb128(uint128_t(624485)), bytes({ 0xe5, 0x8e, 0x26 }));
+    EXPECT_EQ(leb128(max).size(), 19);
+    EXPECT_EQ(leb128(max).back(), std::byte{ 0x03 });
+
+    // every bit length, both all-ones and a single bit, against the reference
+    for (int bit = 0; bit < 128; ++bit) {
+        for (const uint128_t value : { uint128_1 << bit, (uint128_1 << bit) - 1, (uint128_1 << bit) | 0x55 }) {
+            const auto encoded = leb128(value);
+            EXPECT_EQ(encoded, leb128_reference(value)) << bit;
+
+            uint128_t decoded;
+            const auto [ptr, ec] = decode_leb128(encoded.data(), encoded.data() + encoded.size(), decoded);
+            EXPECT_EQ(ec, std::errc{});
+            EXPECT_EQ(ptr, encoded.data() + encoded.size());
+            EXPECT_EQ(decoded, value) << bit;
+        }
+    }
+}
+
+TEST(Codec, leb128_errors){
+    uint128_t value(42);
+
+    std::array<std::byte, 2> small{};
+    EXPECT_EQ(encode_leb128(small.data(), small.data() + small.size(), uint128_t(1) << 20).ec, std::errc::value_too_large);
+    EXPECT_EQ(encode_leb128(small.data(), small.data(), uint128_t(0)).ec, std::errc::value_too_large);
+
+    // truncated
+    const auto truncated = bytes({ 0x80, 0x80 });
+    auto res = decode_leb128(truncated.data(), truncated.data() + truncated.size(), value);
+    EXPECT_EQ(res.ec, std::errc::invalid_argument);
+    EXPECT_EQ(res.ptr, truncated.data());
+    EXPECT_EQ(decode_leb128(truncated.data(), truncated.data(), value).ec, std::errc::invalid_argument);
+
+    // 2^128 does not fit
+    auto too_large = leb128(max);
+    too_large.back() = std::byte{ 0x04 };
+    res = decode_leb128(too_large.data(), too_large.data() + too_large.size(), value);
+    EXPECT_EQ(res.ec, std::errc::result_out_of_range);
+    EXPECT_EQ(res.ptr, too_large.data() + too_large.size());
+
+    // too many bytes, even for a small value
+    std::vector<std::byte> overlong(20, std::byte{ 0x80 });
+    overlong.push_back(std::byte{ 0x00 });
+    EXPECT_EQ(decode_leb128(overlong.data(), overlong.data() + overlong.size(), value).ec, std::errc::result_out_of_range);
+    std::vector<std::byte> endless(30, std::byte{ 0xff });
+    res = decode_leb128(endless.data(), endless.data() + endless.size(), value);
+    EXPECT_EQ(res.ec, std::errc::invalid_argument);
+    EXPECT_EQ(res.ptr, endless.data());
+
+    // past 24 bytes the end of the value is still its stop byte, so a caller can resync
+    std::vector<std::byte> run(30, std::byte{ 0x80 });
+    run.push_back(std::byte{ 0x01 });
+    run.push_back(std::byte{ 0x2a });
+    res = decode_leb128(run.data(), run.data() + run.size(), value);
+    EXPECT_EQ(res.ec, std::errc::result_out_of_range);
+    EXPECT_EQ(res.ptr, run.data() + 31);
+
+    EXPECT_EQ(value, 42);
+
+    // overlong but within 19 bytes is accepted
+    const auto padded = bytes({ 0x81, 0x80, 0x00 });
+    EXPECT_EQ(decode_leb128(padded.data(), padded.data() + padded.size(), value).ec, std::errc{});
+    EXPECT_EQ(value, 1);
+}
+
+TEST(Codec, compact){
+    std::array<std::byte, compact_max_size> buffer{};
+    const auto encode = [&](const uint128_t value) {
+        const auto [ptr, ec] = encode_compact(buffer.data(), buffer.data() + buffer.size(), value);
+        EXPECT_EQ(ec, std::errc{});
+        return std::vector<std::byte>(buffer.data(), ptr);
+    };
+
+    EXPECT_EQ(encode(uint128_t(0)), bytes({ 0x00 }));
+    EXPECT_EQ(encode(uint128_t(0x1234)), bytes({ 0x02, 0x34, 0x12 }));
+    EXPECT_EQ(encode(max).size(), 17);
+
+    for (int bit = 0; bit < 128; ++bit) {
+        for (const uint128_t value : { uint128_1 << bit, (uint128_1 << bit) - 1 }) {
+            const auto encoded = encode(value);
+            EXPECT_EQ(encoded.size(), 1 + value.compact_size());
+
+            // exactly sized input and input with more bytes after the value
+            auto longer = encoded;
+            longer.resize(40, std::byte{ 0xff });
+            for (const auto & in : { encoded, longer }) {
+                uint128_t decoded;
+                const auto [ptr, ec] = decode_compact(in.data(), in.data() + in.size(), decoded);
+                EXPECT_EQ(ec, std::errc{});
+                EXPECT_EQ(ptr, in.data() + encoded.size());
+                EXPECT_EQ(decoded, value) << bit;
+            }
+        }
+    }
+
+    uint128_t value(42);
+    const auto bad_length = bytes({ 17 });
+    EXPECT_EQ(decode_compact(bad_length.data(), bad_length.data() + 1, value).ec, std::errc::invalid_argument);
+    const auto truncated = bytes({ 3, 1, 2 });
+    EXPECT_EQ(decode_compact(truncated.data(), truncated.data() + truncated.size(), value).ec, std::errc::invalid_argument);
+    EXPECT_EQ(value, 42);
+    EXPECT_EQ(encode_compact(buffer.data(), buffer.data() + 2, uint128_t(0x1234)).ec, std::errc::value_too_large);
+}
+
+TEST(Codec, batch){
+    uint64_t state = 0x0123456789abcdefULL;
+    const auto next = [&] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    std::vector<uint128_t> values(1000);
+    for (auto & value : values) {
+        value = uint128_t(next(), next()) >> (next() & 127);
+    }
+
+    for (const bool compact : { false, true }) {
+        std::vector<std::byte> wire(values.size() * leb128_max_size);
+        const auto encoded = compact ? encode_compact(values, wire) : encode_leb128(values, wire);
+        EXPECT_EQ(encoded.ec, std::errc{});
+        EXPECT_EQ(encoded.count, values.size());
+
+        // same bytes as one value at a time
+        std::byte const * p = wire.data();
+        for (const auto & value : values) {
+            std::vector<std::byte> single(leb128_max_size);
+            const auto end = compact ? encode_compact(single.data(), single.data() + single.size(), value).ptr
+                                     : encode_leb128(single.data(), single.data() + single.size(), value).ptr;
+            single.resize(static_cast<std::size_t>(end - single.data()));
+            EXPECT_TRUE(std::equal(single.begin(), single.end(), p));
+            p += single.size();
+        }
+        EXPECT_EQ(p, encoded.ptr);
+
+        std::vector<uint128_t> decoded(values.size() + 1);
+        const std::span<std::byte const> in(wire.data(), encoded.ptr);
+        const auto res = compact ? decode_compact(in, decoded) : decode_leb128(in, decoded);
+        EXPECT_EQ(res.ec, std::errc{});
+        EXPECT_EQ(res.count, values.size());
+        EXPECT_EQ(res.ptr, encoded.ptr);
+        decoded.pop_back();
+        EXPECT_EQ(decoded, values);
+
+        // output that fills up part way
+        std::vector<std::byte> small(100);
+        const auto partial = compact ? encode_compact(values, small) : encode_leb128(values, small);
+        EXPECT_EQ(partial.ec, std::errc::value_too_large);
+        EXPECT_GT(partial.count, 0);
+        EXPECT_TRUE(std::equal(small.data(), partial.ptr, wire.data()));
+    }
+}
+
+TEST(Codec, constexpr){
+    static_assert([] {
+        std::byte buffer[leb128_max_size]{};
+        const uint128_t value(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+        auto const end = encode_leb128(std::begin(buffer), std::end(buffer), value).ptr;
+        uint128_t decoded;
+        decode_leb128(std::begin(buffer), end, decoded);
+
+        std::byte compact[compact_max_size]{};
+        auto const compact_end = encode_compact(std::begin(compact), std::end(compact), value).ptr;
+        uint128_t decoded_compact;
+        decode_compact(std::begin(compact), compact_end, decoded_compact);
+        return decoded == value && decoded_compact == value;
+    }());
+}
@@ -0,0 +1,72 @@
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "uint128_counter.h"
+
+TEST(Counter, slots) {
+    EXPECT_EQ(striped_uint128_counter{ 0 }.slot_count(), 1);
+    EXPECT_EQ(striped_uint128_counter{ 1 }.slot_count(), 1);
+    EXPECT_EQ(striped_uint128_counter{ 5 }.slot_count(), 8);
+    EXPECT_GE(striped_uint128_counter{}.slot_count(), 1);
+}
+
+TEST(Counter, add) {
+    striped_uint128_counter counter{ 4 };
+    EXPECT_EQ(counter.read(), 0);
+
+    counter.add(1);
+    counter.add(uint64_t{ 41 });
+    counter += 100;
+    EXPECT_EQ(counter.read(), 142);
+
+    // large adds go straight to the total
+    counter.add(0xffffffffffffffffULL);
+    counter.add(uint128_t(5, 0));
+    EXPECT_EQ(counter.read(), uint128_t(5, 0) + 0xffffffffffffffffULL + 142);
+}
+
+TEST(Counter, spill) {
+    striped_uint128_counter counter{ 1 };
+
+    // just below the direct threshold, so that the slot crosses 2^63 several times
+    constexpr std::uint64_t step = (std::uint64_t{ 1 } << 56) - 1;
+    uint128_t expected = 0;
+    for (int i = 0; i < 1000; ++i) {
+        counter.add(step);
+        expected += step;
+    }
+    EXPECT_GT(expected, uint128_t(0, 1) << 64);
+    EXPECT_EQ(counter.read(), expected);
+}
+
+TEST(Counter, threads) {
+    constexpr std::size_t thread_count = 8;
+    constexpr std::size_t adds = 20000;
+
+    striped_uint128_counter counter{ 4 };
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&counter, t] {
+            for (std::size_t i = 0; i < adds; ++i) {
+                counter.add(t + 1);
+            }
+        });
+    }
+
+    // concurrent reads only grow
+    uint128_t previous = 0;
+    for (int i = 0; i < 1000; ++i) {
+        auto const current = counter.read();
+        EXPECT_GE(current, previous);
+        previous = current;
+    }
+
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counter.read(), adds * thread_count * (thread_count + 1) / 2);
+}
@@ -39,3 +39,108 @@ TEST(External, divide){
     EXPECT_EQ(u32 /= val, (uint32_t) 0x163356bULL);
     EXPECT_EQ(u64 /= val, (uint64_t) 0x163356b88ac0de0ULL);
 }
+
+TEST(Arithmetic, divide_64bit_divisor){
+    const uint128_t val(0xfedcba9876543210ULL, 0x0123456789abcdefULL);
+
+    EXPECT_EQ(val / uint128_t(0x10), uint128_t(0x0fedcba987654321ULL, 0x00123456789abcdeULL));
+    EXPECT_EQ(val / uint128_t(0xffffffffffffffffULL), uint128_t(0, 0xfedcba9876543211ULL));
+    EXPECT_EQ(val / uint128_t(0xfedcba9876543210ULL), uint128_t(1, 0));
+    EXPECT_EQ(uint128_t(0xffffffffffffffffULL) / uint128_t(3), uint128_t(0x5555555555555555ULL));
+}
+
+TEST(Arithmetic, divide_128bit_divisor){
+    const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+
+    EXPECT_EQ(max / max, 1);
+    EXPECT_EQ(max / uint128_t(1, 0), uint128_t(0xffffffffffffffffULL));
+    EXPECT_EQ(max / uint128_t(0x8000000000000000ULL, 0), 1);
+    EXPECT_EQ(max / uint128_t(0x7fffffffffffffffULL, 0xffffffffffffffffULL), 2);
+    EXPECT_EQ(uint128_t(0xfedcba9876543210ULL, 0) / uint128_t(0x0123456789abcdefULL, 0x0123456789abcdefULL), 0xe0);
+}
+
+TEST(Arithmetic, divide_reconstructs){
+    // deterministic xorshift so that every run covers the same operands
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    auto next = [&state] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    for (int i = 0; i < 10000; ++i) {
+        const uint128_t lhs(next(), next());
+        const uint64_t shape = next();
+        uint128_t rhs(next() >> (shape & 63), next());
+        rhs >>= (shape >> 8) & 127;
+        if (!rhs) {
+            rhs = 1;
+        }
+
+        const uint128_t q = lhs / rhs;
+        const uint128_t r = lhs % rhs;
+        EXPECT_LT(r, rhs);
+        EXPECT_EQ(q * rhs + r, lhs);
+    }
+}
+
+TEST(Arithmetic, divide_constexpr){
+    constexpr uint128_t lhs(0xfedcba9876543210ULL, 0x0123456789abcdefULL);
+    static_assert(lhs / uint128_t(0x10) == uint128_t(0x0fedcba987654321ULL, 0x00123456789abcdeULL));
+    static_assert(lhs / uint128_t(0x0123456789abcdefULL, 0x0123456789abcdefULL) == 0xe0);
+    static_assert(lhs / uint128_t(0xffffffffffffffffULL) == uint128_t(0, 0xfedcba9876543211ULL));
+    static_assert(lhs / lhs == 1);
+
+    // the constant-evaluation path must agree with the hardware path
+    constexpr uint128_t divisor(0x0000000000000001ULL, 0x23456789abcdef01ULL);
+    constexpr uint128_t quotient = lhs / divisor;
+    constexpr uint128_t remainder = lhs % divisor;
+    EXPECT_EQ(lhs / divisor, quotient);
+    EXPECT_EQ(lhs % divisor, remainder);
+}
+
+TEST(Arithmetic, divide_by_integral){
+    const uint128_t val(0xfedcba9876543210ULL, 0x0123456789abcdefULL);
+
+    // upper word below the divisor: one 128/64 step
+    EXPECT_EQ(uint128_t(5, 0) / 7ULL, uint128_t(5, 0) / uint128_t(7));
+    EXPECT_EQ(uint128_t(5, 0) % 7ULL, uint128_t(5, 0) % uint128_t(7));
+    EXPECT_EQ(val / 0xfedcba9876543211ULL, uint128_t(0, 0xffffffffffffffffULL));
+    EXPECT_EQ(val / 0x10u, uint128_t(0x0fedcba987654321ULL, 0x00123456789abcdeULL));
+    EXPECT_EQ(val % 0x10u, 0xf);
+    EXPECT_EQ(val / uint8_t{ 1 }, val);
+    EXPECT_EQ(val / true, val);
+    EXPECT_EQ(uint128_t(100) / 7, 14);
+    EXPECT_EQ(uint128_t(100) % 7, 2);
+    EXPECT_THROW(static_cast<void>(val / 0), std::domain_error);
+    EXPECT_THROW(static_cast<void>(val % 0u), std::domain_error);
+
+    // negative divisors sign-extend to 128 bits
+    EXPECT_EQ(val / -1, 0);
+    EXPECT_EQ(val % -1, val);
+    EXPECT_EQ(uint128_t(-1) / -1, 1);
+
+    uint128_t acc = val;
+    acc /= 3;
+    EXPECT_EQ(acc, val / uint128_t(3));
+    acc %= 1000u;
+    EXPECT_EQ(acc, val / uint128_t(3) % uint128_t(1000));
+
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    auto next = [&state] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int i = 0; i < 10000; ++i) {
+        const uint128_t lhs(next() >> (next() & 63), next());
+        const uint64_t rhs = (next() >> (next() & 63)) | 1;
+        EXPECT_EQ(lhs / rhs, lhs / uint128_t(rhs));
+        EXPECT_EQ(lhs % rhs, lhs % uint128_t(rhs));
+    }
+
+    static_assert(uint128_t(0xfedcba9876543210ULL, 0x0123456789abcdefULL) / 0x10u == uint128_t(0x0fedcba987654321ULL, 0x00123456789abcdeULL));
+    static_assert(uint128_t(5, 0) % 7u == uint128_t(5, 0) % uint128_t(7));
+}
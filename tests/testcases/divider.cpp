@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include "uint128_divider.h"
+
+namespace {
+
+// deterministic xorshift so that every run covers the same operands
+struct xorshift {
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+
+    auto operator()() -> uint64_t {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+template <bool BranchFree>
+void check_divisor(uint128_t const divisor, xorshift & next) {
+    const basic_uint128_divider<BranchFree> divider(divisor);
+    EXPECT_EQ(divider.divisor(), divisor);
+
+    const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+    for (const uint128_t numerator : { uint128_t(0), uint128_t(1), divisor - 1, divisor, divisor + 1, max - 1, max }) {
+        EXPECT_EQ(numerator / divider, numerator / divisor);
+        EXPECT_EQ(numerator % divider, numerator % divisor);
+    }
+
+    for (int i = 0; i < 64; ++i) {
+        const uint128_t numerator = uint128_t(next(), next()) >> (next() & 127);
+        const uint128_div_t res = divider.divmod(numerator);
+        EXPECT_EQ(res.quot, numerator / divisor);
+        EXPECT_EQ(res.rem,  numerator % divisor);
+    }
+}
+
+}
+
+TEST(Divider, divide){
+    xorshift next;
+
+    for (uint64_t small = 2; small < 300; ++small) {
+        check_divisor<false>(uint128_t(small), next);
+        check_divisor<true>(uint128_t(small), next);
+    }
+
+    for (int i = 0; i < 500; ++i) {
+        uint128_t divisor = uint128_t(next(), next()) >> (next() & 127);
+        if (divisor < 2) {
+            divisor = 2;
+        }
+        check_divisor<false>(divisor, next);
+        check_divisor<true>(divisor, next);
+    }
+}
+
+TEST(Divider, power_of_two){
+    xorshift next;
+
+    for (uint8_t shift = 1; shift < 128; ++shift) {
+        check_divisor<false>(uint128_t(1) << shift, next);
+        check_divisor<true>(uint128_t(1) << shift, next);
+    }
+
+    check_divisor<false>(uint128_t(1), next);
+}
+
+TEST(Divider, limits){
+    xorshift next;
+
+    const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+    check_divisor<false>(max, next);
+    check_divisor<true>(max, next);
+    check_divisor<false>(max - 1, next);
+    check_divisor<true>(max - 1, next);
+    check_divisor<false>(uint128_t(0xffffffffffffffffULL), next);
+    check_divisor<true>(uint128_t(0xffffffffffffffffULL), next);
+    check_divisor<false>(uint128_t(1, 1), next);
+    check_divisor<true>(uint128_t(1, 1), next);
+}
+
+TEST(Divider, assignment){
+    const uint128_divider divider(uint128_t(7));
+
+    uint128_t value(0xfedcba9876543210ULL, 0x0123456789abcdefULL);
+    const uint128_t expected_quot = value / 7;
+    const uint128_t expected_rem = value % 7;
+
+    uint128_t rem = value;
+    EXPECT_EQ(value /= divider, expected_quot);
+    EXPECT_EQ(rem %= divider, expected_rem);
+}
+
+TEST(Divider, invalid){
+    EXPECT_THROW(uint128_divider(uint128_t(0)), std::domain_error);
+    EXPECT_THROW(uint128_branchfree_divider(uint128_t(0)), std::domain_error);
+    EXPECT_THROW(uint128_branchfree_divider(uint128_t(1)), std::invalid_argument);
+}
+
+TEST(Divider, constexpr){
+    constexpr uint128_divider divider(uint128_t(10));
+    constexpr uint128_branchfree_divider branchfree(uint128_t(0x0123456789abcdefULL, 0x0123456789abcdefULL));
+    constexpr uint128_t value(0xfedcba9876543210ULL, 0x0123456789abcdefULL);
+
+    static_assert(value / divider == value / 10);
+    static_assert(value % divider == value % 10);
+    static_assert(value / branchfree == 0xe0);
+}
+
+TEST(Divider, divide_by){
+    constexpr uint128_t ten_19(0, 10000000000000000000ULL);
+    constexpr uint128_t ten_38 = ten_19 * ten_19;
+
+    xorshift next;
+    constexpr uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+    for (int i = 0; i < 1000; ++i) {
+        const uint128_t numerator = i ? uint128_t(next(), next()) >> (next() & 127) : max;
+
+        EXPECT_EQ(divide_by<uint128_t(10)>(numerator), numerator / 10);
+        EXPECT_EQ(mod_by<uint128_t(10)>(numerator),    numerator % 10);
+        EXPECT_EQ(divide_by<ten_19>(numerator), numerator / ten_19);
+        EXPECT_EQ(mod_by<ten_19>(numerator),    numerator % ten_19);
+        EXPECT_EQ(divide_by<ten_38>(numerator), numerator / ten_38);
+        EXPECT_EQ(mod_by<ten_38>(numerator),    numerator % ten_38);
+        EXPECT_EQ(divide_by<uint128_t(1, 0)>(numerator), numerator >> 64);
+        EXPECT_EQ(mod_by<uint128_t(1, 0)>(numerator),    numerator.lower());
+        EXPECT_EQ(divide_by<max>(numerator), numerator / max);
+        EXPECT_EQ(divide_by<uint128_t(7)>(numerator), numerator / 7);
+        EXPECT_EQ(divide_by<uint128_t(1)>(numerator), numerator);
+        EXPECT_EQ(mod_by<uint128_t(1)>(numerator), 0);
+    }
+
+    static_assert(divide_by<ten_19>(ten_38 + 5) == ten_19);
+    static_assert(mod_by<ten_19>(ten_38 + 5) == 5);
+}
+
+TEST(Divider, structural){
+    // uint128_t is a structural type, so it works as a non-type template parameter
+    constexpr auto value = std::integral_constant<uint128_t, uint128_t(1, 2)>::value;
+    EXPECT_EQ(value.upper(), 1);
+    EXPECT_EQ(value.lower(), 2);
+}
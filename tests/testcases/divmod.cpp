@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "uint128.h"
+
+TEST(Arithmetic, div){
+    const uint128_t lhs(0xfedcba9876543210ULL, 0x0123456789abcdefULL);
+    const uint128_t rhs(0x0123456789abcdefULL, 0x0123456789abcdefULL);
+
+    const uint128_div_t res = div(lhs, rhs);
+    EXPECT_EQ(res.quot, lhs / rhs);
+    EXPECT_EQ(res.rem,  lhs % rhs);
+
+    EXPECT_TRUE(noexcept(div(lhs, rhs)));
+
+    const uint128_div_t small = div(uint128_t(17), uint128_t(5));
+    EXPECT_EQ(small.quot, 3);
+    EXPECT_EQ(small.rem,  2);
+
+    const uint128_div_t less = div(uint128_t(5), uint128_t(17));
+    EXPECT_EQ(less.quot, 0);
+    EXPECT_EQ(less.rem,  5);
+}
+
+TEST(Arithmetic, divmod){
+    const uint128_t lhs(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+    const uint128_t rhs(0xfedcba9876543210ULL);
+
+    const auto [quot, rem] = divmod(lhs, rhs);
+    EXPECT_EQ(quot, lhs / rhs);
+    EXPECT_EQ(rem,  uint128_t(0x7f598f328cc265bfULL));
+
+    EXPECT_THROW((void)divmod(uint128_t(1), uint128_t(0)), std::domain_error);
+    EXPECT_THROW((void)divmod(uint128_t(1), 0), std::domain_error);
+}
+
+TEST(Arithmetic, checked_divmod){
+    const uint128_t lhs(0xfedcba9876543210ULL, 0x0123456789abcdefULL);
+    const uint128_t rhs(0x10);
+
+    const auto res = checked_divmod(lhs, rhs);
+    ASSERT_TRUE(res.has_value());
+    EXPECT_EQ(res->quot, uint128_t(0x0fedcba987654321ULL, 0x00123456789abcdeULL));
+    EXPECT_EQ(res->rem,  0xf);
+
+    EXPECT_FALSE(checked_divmod(lhs, uint128_t(0)).has_value());
+    EXPECT_TRUE(noexcept(checked_divmod(lhs, rhs)));
+}
+
+TEST(Arithmetic, divmod_integral){
+    const uint128_t lhs(0xfedcba9876543210ULL, 0x0123456789abcdefULL);
+
+    // not ambiguous with div(int, int) and div(long, long)
+    const uint128_div_t res = div(lhs, 10);
+    EXPECT_EQ(res.quot, lhs / 10);
+    EXPECT_EQ(res.rem,  lhs % 10);
+    EXPECT_TRUE(noexcept(div(lhs, 10)));
+
+    EXPECT_EQ(div(lhs, 0x10U), div(lhs, uint128_t(0x10)));
+    EXPECT_EQ(div(lhs, uint64_t(0xfedcba9876543210ULL)), div(lhs, uint128_t(0xfedcba9876543210ULL)));
+    EXPECT_EQ(divmod(lhs, 7LL), div(lhs, uint128_t(7)));
+
+    // negative divisors convert to uint128_t like the operators
+    EXPECT_EQ(div(lhs, -1), div(lhs, uint128_t(-1)));
+    EXPECT_EQ(divmod(lhs, short(-3)), div(lhs, uint128_t(short(-3))));
+
+    ASSERT_TRUE(checked_divmod(lhs, 3).has_value());
+    EXPECT_EQ(*checked_divmod(lhs, 3), div(lhs, uint128_t(3)));
+    EXPECT_FALSE(checked_divmod(lhs, 0).has_value());
+
+    static_assert(div(uint128_t(17), 5) == uint128_div_t{ uint128_t(3), uint128_t(2) });
+}
+
+TEST(Arithmetic, divmod_constexpr){
+    constexpr uint128_t lhs(0xfedcba9876543210ULL, 0x0123456789abcdefULL);
+
+    static_assert(div(lhs, uint128_t(0x10)) == uint128_div_t{ uint128_t(0x0fedcba987654321ULL, 0x00123456789abcdeULL), uint128_t(0xf) });
+    static_assert(divmod(lhs, lhs) == uint128_div_t{ uint128_t(1), uint128_t(0) });
+    static_assert(!checked_divmod(lhs, uint128_t(0)).has_value());
+}
@@ -0,0 +1,151 @@
+#include <iterator>
+#include <locale>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "uint128_format.h"
+
+namespace {
+
+// formats `value` with the spec between "{:" and "}", resolving a dynamic width to `dynamic_width`
+auto format(std::string_view const spec_text, uint128_t const value, std::size_t const dynamic_width = 0,
+            char const separator = ',', std::string_view const grouping = {}) -> std::string {
+    uint128::details::format_spec spec;
+    auto const [ptr, error] = uint128::details::parse_format_spec(spec_text.data(), spec_text.data() + spec_text.size(), spec);
+    EXPECT_EQ(error, nullptr) << spec_text;
+    EXPECT_EQ(ptr, spec_text.data() + spec_text.size()) << spec_text;
+
+    std::size_t const width = spec.width_arg == uint128::details::no_arg_id ? spec.width : dynamic_width;
+    std::string out;
+    uint128::details::format_uint128(std::back_inserter(out), value, spec, width, separator, grouping);
+    return out;
+}
+
+auto spec_error(std::string_view const spec_text) -> bool {
+    uint128::details::format_spec spec;
+    return uint128::details::parse_format_spec(spec_text.data(), spec_text.data() + spec_text.size(), spec).error != nullptr;
+}
+
+const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+
+}
+
+TEST(Format, types){
+    const uint128_t value(0xab);
+    EXPECT_EQ(format("", value), "171");
+    EXPECT_EQ(format("d", value), "171");
+    EXPECT_EQ(format("x", value), "ab");
+    EXPECT_EQ(format("X", value), "AB");
+    EXPECT_EQ(format("o", value), "253");
+    EXPECT_EQ(format("b", value), "10101011");
+    EXPECT_EQ(format("B", value), "10101011");
+    EXPECT_EQ(format("", max), "340282366920938463463374607431768211455");
+    EXPECT_EQ(format("X", max), std::string(32, 'F'));
+    EXPECT_EQ(format("b", max), std::string(128, '1'));
+}
+
+TEST(Format, alternate_and_sign){
+    const uint128_t value(0xab);
+    EXPECT_EQ(format("#x", value), "0xab");
+    EXPECT_EQ(format("#X", value), "0XAB");
+    EXPECT_EQ(format("#o", value), "0253");
+    EXPECT_EQ(format("#o", uint128_0), "0");
+    EXPECT_EQ(format("#b", value), "0b10101011");
+    EXPECT_EQ(format("#B", value), "0B10101011");
+    EXPECT_EQ(format("#d", value), "171");
+    EXPECT_EQ(format("+", value), "+171");
+    EXPECT_EQ(format(" ", value), " 171");
+    EXPECT_EQ(format("-", value), "171");
+    EXPECT_EQ(format("+#x", value), "+0xab");
+}
+
+TEST(Format, width_and_align){
+    const uint128_t value(42);
+    EXPECT_EQ(format("5", value), "   42");
+    EXPECT_EQ(format("<5", value), "42   ");
+    EXPECT_EQ(format(">5", value), "   42");
+    EXPECT_EQ(format("^5", value), " 42  ");
+    EXPECT_EQ(format("_^6x", value), "__2a__");
+    EXPECT_EQ(format("*<#6x", value), "0x2a**");
+    EXPECT_EQ(format("1", value), "42");
+
+    // zero padding goes after the prefix, and is ignored with an explicit alignment
+    EXPECT_EQ(format("06", value), "000042");
+    EXPECT_EQ(format("#06x", value), "0x002a");
+    EXPECT_EQ(format("+06", value), "+00042");
+    EXPECT_EQ(format("<06", value), "42    ");
+    EXPECT_EQ(format("#034x", uint128_t(0x2a)), "0x" + std::string(30, '0') + "2a");
+
+    // a multi-byte fill character counts as one column
+    EXPECT_EQ(format("\xc2\xb7>4", value), "\xc2\xb7\xc2\xb7" "42");
+
+    // dynamic width
+    EXPECT_EQ(format("{}", value, 4), "  42");
+    EXPECT_EQ(format("_>{1}", value, 3), "_42");
+}
+
+TEST(Format, localized){
+    EXPECT_EQ(format("L", uint128_t(1234567), 0, ',', "\3"), "1,234,567");
+    EXPECT_EQ(format("L", uint128_t(123), 0, ',', "\3"), "123");
+    EXPECT_EQ(format("L", uint128_t(123456), 0, ',', "\3"), "123,456");
+    EXPECT_EQ(format("L", uint128_t(1234567890), 0, '.', "\3\2"), "1.23.45.67.890");
+    EXPECT_EQ(format("L", uint128_t(1234567), 0, ',', ""), "1234567");
+    EXPECT_EQ(format("L", uint128_t(1234567), 0, ',', "\3\x7f"), "1234,567");
+    EXPECT_EQ(format("Lx", uint128_t(0xabcdef), 0, '\'', "\2"), "ab'cd'ef");
+    EXPECT_EQ(format("L", max, 0, ',', "\1").size(), 39 * 2 - 1);
+    EXPECT_EQ(format("012L", uint128_t(1234567), 0, ',', "\3"), "0001,234,567");
+}
+
+TEST(Format, invalid_spec){
+    EXPECT_TRUE(spec_error(".3"));
+    EXPECT_TRUE(spec_error("c"));
+    EXPECT_TRUE(spec_error("s"));
+    EXPECT_TRUE(spec_error("xx"));
+    EXPECT_TRUE(spec_error("{<5"));
+    EXPECT_TRUE(spec_error("{a}"));
+    EXPECT_TRUE(spec_error("{0"));
+    EXPECT_TRUE(spec_error("99999999999"));
+    EXPECT_FALSE(spec_error("}"));
+    EXPECT_FALSE(spec_error("*^+#012Lx"));
+}
+
+TEST(Format, constexpr){
+    static_assert([] {
+        constexpr std::string_view text = "_^#10x";
+        uint128::details::format_spec spec;
+        uint128::details::parse_format_spec(text.data(), text.data() + text.size(), spec);
+        char out[10]{};
+        uint128::details::format_uint128(out, uint128_t(0xff), spec, spec.width);
+        return std::string_view(out, 10) == "___0xff___";
+    }());
+}
+
+#if defined(__cpp_lib_format)
+namespace {
+
+struct thousands : std::numpunct<char> {
+    auto do_thousands_sep() const -> char override { return ','; }
+    auto do_grouping() const -> std::string override { return "\3"; }
+};
+
+}
+
+TEST(Format, std_format){
+    const uint128_t value(0xfedcba9876543210ULL, 0x0123456789abcdefULL);
+    EXPECT_EQ(std::format("{}", value), value.str());
+    EXPECT_EQ(std::format("{:#x}", value), "0xfedcba98765432100123456789abcdef");
+    EXPECT_EQ(std::format("{:>40}", uint128_t(7)), std::string(39, ' ') + "7");
+    EXPECT_EQ(std::format("{:_^{}x}", uint128_t(255), 6), "__ff__");
+    EXPECT_EQ(std::format("{0:o} {0:b}", uint128_t(8)), "10 1000");
+    EXPECT_EQ(std::format(std::locale::classic(), "{:L}", uint128_t(1234567)), "1234567");
+    EXPECT_EQ(std::format(std::locale(std::locale::classic(), new thousands), "{:L}", max), "340,282,366,920,938,463,463,374,607,431,768,211,455");
+    EXPECT_THROW((void)std::vformat("{:c}", std::make_format_args(value)), std::format_error);
+
+    char buffer[8];
+    auto const res = std::format_to_n(buffer, sizeof(buffer), "{:X}", max);
+    EXPECT_EQ(res.size, 32);
+    EXPECT_EQ(std::string_view(buffer, sizeof(buffer)), "FFFFFFFF");
+}
+#endif
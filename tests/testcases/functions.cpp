@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iomanip>
 #include <map>
+#include <sstream>
 
 #include <gtest/gtest.h>
 
@@ -176,6 +181,48 @@ TEST(Function, export_bits_compact_zero_little){
     EXPECT_TRUE(std::ranges::equal(bits4_span.subspan(0, size), compact));
 }
 
+TEST(Function, to_bytes){
+    const uint128_t value(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+
+    const auto big = value.to_bytes();
+    const auto little = value.to_bytes(std::endian::little);
+    for (std::size_t i = 0; i < 16; ++i) {
+        EXPECT_EQ(big[i], little[15 - i]);
+    }
+    EXPECT_EQ(big[0], std::byte{ 0x01 });
+    EXPECT_EQ(big[15], std::byte{ 0x10 });
+
+    EXPECT_EQ(uint128_t::from_bytes(big), value);
+    EXPECT_EQ(uint128_t::from_bytes(little, std::endian::little), value);
+    EXPECT_EQ(uint128_t::from_bytes(big, std::endian::little), uint128_t(0x1032547698badcfeULL, 0xefcdab8967452301ULL));
+
+    // the same bytes as export_bits
+    EXPECT_TRUE(std::ranges::equal(value.export_bits(), big, [](uint8_t const lhs, std::byte const rhs) { return lhs == std::to_integer<uint8_t>(rhs); }));
+
+    static_assert(uint128_t::from_bytes(uint128_t(1, 2).to_bytes(std::endian::little), std::endian::little) == uint128_t(1, 2));
+    static_assert(uint128_t(1, 2).to_bytes()[7] == std::byte{ 1 });
+}
+
+TEST(Function, to_bytes_compact){
+    EXPECT_EQ(uint128_t(0).compact_size(), 0);
+    EXPECT_EQ(uint128_t(0xff).compact_size(), 1);
+    EXPECT_EQ(uint128_t(0x100).compact_size(), 2);
+    EXPECT_EQ(uint128_t(1, 0).compact_size(), 9);
+    EXPECT_EQ(uint128_t(0x8000000000000000ULL, 0).compact_size(), 16);
+
+    std::array<std::byte, 16> bytes{};
+    for (int bit = 0; bit < 128; ++bit) {
+        for (const auto endian : { std::endian::big, std::endian::little }) {
+            const uint128_t value = (uint128_1 << bit) | 0x5a;
+            const auto size = value.to_bytes_compact(bytes, endian);
+            EXPECT_EQ(size, static_cast<std::size_t>(bit / 8 + 1));
+            EXPECT_EQ(uint128_t::from_bytes_compact(std::span{ bytes }.first(size), endian), value);
+        }
+    }
+
+    EXPECT_EQ(uint128_t::from_bytes_compact({}), 0);
+}
+
 TEST(External, ostream){
     const uint128_t value(0xfedcba9876543210ULL);
 
@@ -195,3 +242,100 @@ TEST(External, ostream){
     std::stringstream zero; zero << uint128_t();
     EXPECT_EQ(zero.str(), "0");
 }
+
+TEST(External, ostream_flags){
+    const uint128_t value(0xabULL, 0xcdULL);
+
+    // no basefield is decimal
+    std::stringstream none; none.unsetf(std::ios_base::basefield); none << uint128_t(42);
+    EXPECT_EQ(none.str(), "42");
+
+    std::stringstream hex; hex << std::hex << std::showbase << std::uppercase << value;
+    EXPECT_EQ(hex.str(), "0XAB00000000000000CD");
+
+    // no prefix on zero, like built-in integers
+    std::stringstream zero; zero << std::hex << std::showbase << uint128_t(0);
+    EXPECT_EQ(zero.str(), "0");
+
+    std::stringstream oct; oct << std::oct << std::showbase << uint128_t(8) << ' ' << uint128_t(0);
+    EXPECT_EQ(oct.str(), "010 0");
+
+    std::stringstream right; right << std::setw(6) << std::setfill('*') << uint128_t(42) << uint128_t(7);
+    EXPECT_EQ(right.str(), "****427");
+
+    std::stringstream left; left << std::left << std::setw(6) << uint128_t(42) << '|';
+    EXPECT_EQ(left.str(), "42    |");
+
+    std::stringstream internal; internal << std::internal << std::hex << std::showbase << std::setfill('0') << std::setw(8) << uint128_t(0x2a);
+    EXPECT_EQ(internal.str(), "0x00002a");
+
+    std::stringstream failed; failed.setstate(std::ios_base::failbit); failed << uint128_t(1);
+    EXPECT_EQ(failed.str(), "");
+}
+
+TEST(External, istream){
+    const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+    uint128_t value;
+
+    std::istringstream dec("  340282366920938463463374607431768211455 12x");
+    dec >> value;
+    EXPECT_EQ(value, max);
+    EXPECT_TRUE(dec.good());
+    dec >> value;
+    EXPECT_EQ(value, 12);
+    EXPECT_EQ(dec.get(), 'x');
+
+    std::istringstream hex("FEDCBA9876543210fedcba9876543210 0x1f");
+    hex >> std::hex >> value;
+    EXPECT_EQ(value, uint128_t(0xfedcba9876543210ULL, 0xfedcba9876543210ULL));
+    hex >> value;
+    EXPECT_EQ(value, 0x1f);
+    EXPECT_TRUE(hex.eof());
+    EXPECT_FALSE(hex.fail());
+
+    std::istringstream oct("777 8");
+    oct >> std::oct >> value;
+    EXPECT_EQ(value, 0777);
+    oct >> value;
+    EXPECT_TRUE(oct.fail());
+    EXPECT_EQ(value, 0);
+
+    // no basefield: the prefix decides
+    std::istringstream detect("0x10 010 10 0 +5");
+    detect.unsetf(std::ios_base::basefield);
+    uint128_t a, b, c, d, e;
+    detect >> a >> b >> c >> d >> e;
+    EXPECT_EQ(a, 16);
+    EXPECT_EQ(b, 8);
+    EXPECT_EQ(c, 10);
+    EXPECT_EQ(d, 0);
+    EXPECT_EQ(e, 5);
+    EXPECT_FALSE(detect.fail());
+
+    // overflow consumes the digits and stores the maximum value
+    std::istringstream overflow("340282366920938463463374607431768211456;");
+    overflow >> value;
+    EXPECT_TRUE(overflow.fail());
+    EXPECT_EQ(value, max);
+    overflow.clear();
+    EXPECT_EQ(overflow.get(), ';');
+
+    // a prefix without hexadecimal digits
+    std::istringstream prefix("0xg");
+    prefix >> std::hex >> value;
+    EXPECT_TRUE(prefix.fail());
+    EXPECT_EQ(value, 0);
+
+    std::istringstream empty("-1");
+    empty >> value;
+    EXPECT_TRUE(empty.fail());
+    EXPECT_EQ(value, 0);
+
+    // round trip
+    std::stringstream trip;
+    trip << max << ' ' << uint128_t(0);
+    uint128_t x, y;
+    trip >> x >> y;
+    EXPECT_EQ(x, max);
+    EXPECT_EQ(y, 0);
+}
@@ -0,0 +1,188 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "uint128_bit.h"
+#include "uint128_gf2.h"
+
+namespace {
+
+struct xorshift {
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+
+    auto operator()() -> uint64_t {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// shift and xor, one bit of b at a time
+auto clmul_reference(uint128_t const a, uint128_t const b) -> uint128_wide_t {
+    uint128_wide_t product{ 0, 0 };
+    for (unsigned i = 0; i < 128; ++i) {
+        if (((b >> i) & 1) != 0) {
+            product.lo ^= a << i;
+            if (i) {
+                product.hi ^= a >> (128 - i);
+            }
+        }
+    }
+    return product;
+}
+
+// multiply by x and reduce, one bit of b at a time
+auto gf2_128_mul_reference(uint128_t a, uint128_t const b) -> uint128_t {
+    uint128_t product = 0;
+    for (unsigned i = 0; i < 128; ++i) {
+        if (((b >> i) & 1) != 0) {
+            product ^= a;
+        }
+        bool const carry = (a >> 127) != 0;
+        a <<= 1;
+        if (carry) {
+            a ^= 0x87;
+        }
+    }
+    return product;
+}
+
+auto absorb_reference(gf2_128 acc, gf2_128 const h, std::vector<uint128_t> const & blocks, std::size_t const count) -> gf2_128 {
+    for (std::size_t i = 0; i < count; ++i) {
+        acc = (acc + gf2_128{ blocks[i] }) * h;
+    }
+    return acc;
+}
+
+}
+
+TEST(GF2, clmul){
+    EXPECT_EQ(clmul(0, 0x0123456789abcdefULL), 0);
+    EXPECT_EQ(clmul(1, 0x0123456789abcdefULL), 0x0123456789abcdefULL);
+    EXPECT_EQ(clmul(3, 3), 5);
+    EXPECT_EQ(clmul(0xffffffffffffffffULL, 0xffffffffffffffffULL), uint128_t(0x5555555555555555ULL, 0x5555555555555555ULL));
+    EXPECT_EQ(clmul(0x8000000000000000ULL, 0x8000000000000000ULL), uint128_t(0x4000000000000000ULL, 0));
+
+    xorshift next;
+    for (int i = 0; i < 1000; ++i) {
+        const uint64_t a = next();
+        const uint64_t b = next();
+        EXPECT_EQ(clmul(a, b), clmul_reference(a, b).lo) << a << " " << b;
+        EXPECT_EQ(clmul(a, b), clmul(b, a));
+    }
+
+    static_assert(clmul(0xffffffffffffffffULL, 0xffffffffffffffffULL) == uint128_t(0x5555555555555555ULL, 0x5555555555555555ULL));
+}
+
+TEST(GF2, clmul_wide){
+    xorshift next;
+    for (int i = 0; i < 1000; ++i) {
+        const uint128_t a(next(), next());
+        const uint128_t b(next(), next());
+        EXPECT_EQ(clmul_wide(a, b), clmul_reference(a, b)) << a << " " << b;
+    }
+
+    const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+    const uint128_t fives(0x5555555555555555ULL, 0x5555555555555555ULL);
+    EXPECT_EQ(clmul_wide(max, max), (uint128_wide_t{ fives, fives }));
+    static_assert(clmul_wide(uint128_t(1, 0), uint128_t(1, 0)) == uint128_wide_t{ 1, 0 });
+}
+
+TEST(GF2, field){
+    const gf2_128 zero;
+    const gf2_128 one{ 1 };
+    const gf2_128 x{ 2 };
+
+    // x^128 = x^7 + x^2 + x + 1
+    EXPECT_EQ(x * gf2_128{ uint128_t(0x8000000000000000ULL, 0) }, gf2_128{ 0x87 });
+    EXPECT_EQ(x.pow(128), gf2_128{ 0x87 });
+    EXPECT_EQ(x.pow(0), one);
+    EXPECT_EQ(zero.inverse(), zero);
+    EXPECT_EQ(one.inverse(), one);
+
+    xorshift next;
+    for (int i = 0; i < 200; ++i) {
+        const gf2_128 a{ uint128_t(next(), next()) };
+        const gf2_128 b{ uint128_t(next(), next()) };
+        const gf2_128 c{ uint128_t(next(), next()) };
+        EXPECT_EQ((a * b).bits(), gf2_128_mul_reference(a.bits(), b.bits())) << a.bits() << " " << b.bits();
+        EXPECT_EQ(a * b, b * a);
+        EXPECT_EQ(a * (b + c), a * b + a * c);
+        EXPECT_EQ(a - b, a + b);
+        EXPECT_EQ(a * one, a);
+        EXPECT_EQ(a * zero, zero);
+        EXPECT_EQ(a * a.inverse(), one) << a.bits();
+        EXPECT_EQ(a.pow(3), a * a * a);
+    }
+
+    static_assert(gf2_128{ 2 } * gf2_128{ uint128_t(0x8000000000000000ULL, 0) } == gf2_128{ 0x87 });
+}
+
+TEST(GF2, ghash){
+    // AES-GCM test case 2 (128-bit key of zeros, one block of zero plaintext): GHASH of the
+    // ciphertext block and the lengths block. GHASH blocks are bit-reflected field elements.
+    const uint128_t h(0x66e94bd4ef8a2c3bULL, 0x884cfa59ca342b2eULL);
+    const uint128_t ciphertext(0x0388dace60b6a392ULL, 0xf328c2b971b2fe78ULL);
+    const uint128_t lengths(0, 128);
+
+    const gf2_128_key key{ gf2_128{ bit_reverse(h) } };
+    const std::vector<uint128_t> blocks = { bit_reverse(ciphertext), bit_reverse(lengths) };
+    const gf2_128 tag = key.absorb(gf2_128{}, blocks);
+
+    EXPECT_EQ(bit_reverse(tag.bits()), uint128_t(0xf38cbb1ad69223dcULL, 0xc3457ae5b6b0f885ULL));
+}
+
+TEST(GF2, absorb){
+    xorshift next;
+    const gf2_128 h{ uint128_t(next(), next()) };
+    const gf2_128_key key{ h };
+    EXPECT_EQ(key.h(), h);
+
+    std::vector<uint128_t> blocks(40);
+    for (auto & block : blocks) {
+        block = uint128_t(next(), next());
+    }
+
+    const gf2_128 start{ uint128_t(next(), next()) };
+    for (std::size_t n = 0; n <= blocks.size(); ++n) {
+        EXPECT_EQ(key.absorb(start, std::span{ blocks }.first(n)), absorb_reference(start, h, blocks, n)) << n;
+    }
+
+    // the same in two calls
+    const gf2_128 first = key.absorb(start, std::span{ blocks }.first(13));
+    EXPECT_EQ(key.absorb(first, std::span{ blocks }.subspan(13)), key.absorb(start, blocks));
+}
+
+TEST(GF2, absorb_kernels){
+    std::vector<uint128::details::gf2_128_absorb_kernel> kernels = { uint128::details::gf2_128_absorb_portable };
+#if defined(UINT128_GF2_X86_DISPATCH)
+    if (__builtin_cpu_supports("pclmul")) {
+        kernels.push_back(uint128::details::gf2_128_absorb_pclmul);
+    }
+    if (__builtin_cpu_supports("vpclmulqdq") && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("pclmul")) {
+        kernels.push_back(uint128::details::gf2_128_absorb_vpclmul);
+    }
+#endif
+
+    xorshift next;
+    const gf2_128 h{ uint128_t(next(), next()) };
+    std::vector<uint128_t> powers(8);
+    for (std::size_t i = 0; i < powers.size(); ++i) {
+        powers[i] = h.pow(8 - i).bits();
+    }
+
+    std::vector<uint128_t> blocks(27);
+    for (auto & block : blocks) {
+        block = uint128_t(next(), next());
+    }
+
+    const gf2_128 start{ uint128_t(next(), next()) };
+    for (const auto kernel : kernels) {
+        for (std::size_t n = 0; n <= blocks.size(); ++n) {
+            EXPECT_EQ(gf2_128{ kernel(powers.data(), start.bits(), blocks.data(), n) }, absorb_reference(start, h, blocks, n)) << n;
+        }
+    }
+}
@@ -74,3 +74,21 @@ TEST(External, shift_left){
     EXPECT_EQ(u32 <<= uint128_t(31), (uint32_t) 0);
     EXPECT_EQ(u64 <<= uint128_t(63), (uint64_t) 0);
 }
+
+TEST(BitShift, left_by_integral){
+    const uint128_t val(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+
+    for (int i = 0; i < 140; ++i) {
+        EXPECT_EQ(val << i, val << uint128_t(i)) << i;
+        EXPECT_EQ(val << static_cast<uint32_t>(i), val << uint128_t(i)) << i;
+    }
+    EXPECT_EQ(val << 64, uint128_t(0xfedcba9876543210ULL, 0));
+    EXPECT_EQ(val << 0, val);
+    EXPECT_EQ(val << 128, 0);
+    EXPECT_EQ(val << uint128_t(1, 0), 0);
+
+    // negative counts sign-extend to 128 bits
+    EXPECT_EQ(val << -1, 0);
+
+    static_assert(uint128_t(1) << 127u == uint128_t(0x8000000000000000ULL, 0));
+}
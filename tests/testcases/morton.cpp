@@ -0,0 +1,180 @@
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "uint128_morton.h"
+
+namespace {
+
+const uint128_t val(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+
+struct xorshift {
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+
+    auto operator()() -> uint64_t {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// one bit at a time, the way keys were built before
+auto morton_reference(uint64_t const x, uint64_t const y) -> uint128_t {
+    uint128_t key = 0;
+    for (unsigned i = 0; i < 64; ++i) {
+        key |= uint128_t((x >> i) & 1) << (2 * i);
+        key |= uint128_t((y >> i) & 1) << (2 * i + 1);
+    }
+    return key;
+}
+
+// one level at a time, mirroring and swapping the remaining bits in the lower quadrants
+auto hilbert_reference(uint64_t x, uint64_t y) -> uint128_t {
+    uint128_t key = 0;
+    for (int i = 63; i >= 0; --i) {
+        const uint64_t rx = (x >> i) & 1;
+        const uint64_t ry = (y >> i) & 1;
+        key = (key << 2) | ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = ~x;
+                y = ~y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return key;
+}
+
+auto pdep_reference(uint128_t const value, uint128_t const mask) -> uint128_t {
+    uint128_t result = 0;
+    unsigned next = 0;
+    for (unsigned i = 0; i < 128; ++i) {
+        if (((mask >> i) & 1) != 0) {
+            result |= ((value >> next++) & 1) << i;
+        }
+    }
+    return result;
+}
+
+auto pext_reference(uint128_t const value, uint128_t const mask) -> uint128_t {
+    uint128_t result = 0;
+    unsigned next = 0;
+    for (unsigned i = 0; i < 128; ++i) {
+        if (((mask >> i) & 1) != 0) {
+            result |= ((value >> i) & 1) << next++;
+        }
+    }
+    return result;
+}
+
+}
+
+TEST(Morton, pdep_pext){
+    const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+
+    EXPECT_EQ(pdep(val, max), val);
+    EXPECT_EQ(pext(val, max), val);
+    EXPECT_EQ(pdep(val, 0), 0);
+    EXPECT_EQ(pext(val, 0), 0);
+    EXPECT_EQ(pdep(uint128_t(0xff), uint128_t(0xf0, 0xf000000000000000ULL)), uint128_t(0xf0, 0xf000000000000000ULL));
+    EXPECT_EQ(pext(uint128_t(0xf0, 0xf000000000000000ULL), uint128_t(0xf0, 0xf000000000000000ULL)), 0xff);
+
+    xorshift next;
+    for (int i = 0; i < 1000; ++i) {
+        const uint128_t value(next(), next());
+        const uint128_t mask(next() & next(), next() | next());
+        EXPECT_EQ(pdep(value, mask), pdep_reference(value, mask)) << value << " " << mask;
+        EXPECT_EQ(pext(value, mask), pext_reference(value, mask)) << value << " " << mask;
+        EXPECT_EQ(pdep(pext(value, mask), mask), value & mask);
+    }
+
+    static_assert(pdep(uint128_t(0b101), uint128_t(1, 0x8000000000000001ULL)) == uint128_t(1, 1));
+    static_assert(pext(uint128_t(1, 1), uint128_t(1, 0x8000000000000001ULL)) == 0b101);
+}
+
+TEST(Morton, morton){
+    EXPECT_EQ(morton_encode(0, 0), 0);
+    EXPECT_EQ(morton_encode(1, 0), 1);
+    EXPECT_EQ(morton_encode(0, 1), 2);
+    EXPECT_EQ(morton_encode(~0ULL, 0), uint128_t(0x5555555555555555ULL, 0x5555555555555555ULL));
+    EXPECT_EQ(morton_encode(0, ~0ULL), uint128_t(0xaaaaaaaaaaaaaaaaULL, 0xaaaaaaaaaaaaaaaaULL));
+    EXPECT_EQ(morton_encode(1ULL << 63, 1ULL << 63), uint128_t(0xc000000000000000ULL, 0));
+
+    xorshift next;
+    for (int i = 0; i < 1000; ++i) {
+        const uint64_t x = next();
+        const uint64_t y = next();
+        const uint128_t key = morton_encode(x, y);
+        EXPECT_EQ(key, morton_reference(x, y)) << x << " " << y;
+        EXPECT_EQ(morton_decode(key), (point64_t{ x, y }));
+    }
+
+    static_assert(morton_decode(morton_encode(0x0123456789abcdefULL, 0xfedcba9876543210ULL)) == point64_t{ 0x0123456789abcdefULL, 0xfedcba9876543210ULL });
+}
+
+TEST(Morton, morton_span){
+    xorshift next;
+    std::vector<uint64_t> xs(1000);
+    std::vector<uint64_t> ys(xs.size());
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = next();
+        ys[i] = next();
+    }
+
+    std::vector<uint128_t> keys(xs.size());
+    morton_encode(xs, ys, keys);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        EXPECT_EQ(keys[i], morton_encode(xs[i], ys[i])) << i;
+    }
+
+    std::vector<uint64_t> decoded_xs(xs.size());
+    std::vector<uint64_t> decoded_ys(xs.size());
+    morton_decode(keys, decoded_xs, decoded_ys);
+    EXPECT_EQ(decoded_xs, xs);
+    EXPECT_EQ(decoded_ys, ys);
+
+    // empty spans
+    morton_encode({}, {}, {});
+    morton_decode({}, {}, {});
+}
+
+TEST(Morton, hilbert){
+    EXPECT_EQ(hilbert_encode(0, 0), 0);
+    EXPECT_EQ(hilbert_decode(0), (point64_t{ 0, 0 }));
+
+    // the curve starts at (0, 0) and ends at (2^64 - 1, 0)
+    const uint128_t last(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+    EXPECT_EQ(hilbert_encode(~0ULL, 0), last);
+    EXPECT_EQ(hilbert_decode(last), (point64_t{ ~0ULL, 0 }));
+
+    // the first 2 x 2 block: 63 levels of lower-left quadrants transpose it
+    EXPECT_EQ(hilbert_encode(0, 1), 3);
+    EXPECT_EQ(hilbert_encode(1, 1), 2);
+    EXPECT_EQ(hilbert_encode(1, 0), 1);
+
+    // consecutive keys are neighbouring cells
+    xorshift next;
+    for (int i = 0; i < 1000; ++i) {
+        const uint128_t key(next(), next());
+        const auto [x0, y0] = hilbert_decode(key);
+        const auto [x1, y1] = hilbert_decode(key + 1);
+        const uint64_t dx = x0 > x1 ? x0 - x1 : x1 - x0;
+        const uint64_t dy = y0 > y1 ? y0 - y1 : y1 - y0;
+        EXPECT_EQ(dx + dy, 1) << key;
+        EXPECT_EQ(hilbert_encode(x0, y0), key);
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        const uint64_t x = next();
+        const uint64_t y = next();
+        EXPECT_EQ(hilbert_encode(x, y), hilbert_reference(x, y)) << x << " " << y;
+        EXPECT_EQ(hilbert_decode(hilbert_encode(x, y)), (point64_t{ x, y }));
+    }
+
+    static_assert(hilbert_decode(hilbert_encode(0x0123456789abcdefULL, 0xfedcba9876543210ULL)) == point64_t{ 0x0123456789abcdefULL, 0xfedcba9876543210ULL });
+}
@@ -40,3 +40,91 @@ TEST(External, multiply){
     EXPECT_EQ(u32 *= val, (uint32_t)         0x5f5f5f60ULL);
     EXPECT_EQ(u64 *= val, (uint64_t) 0x5f5f5f5f5f5f5f60ULL);
 }
+
+TEST(Arithmetic, multiply_constexpr){
+    constexpr uint128_t val(0xfedbca9876543210ULL);
+    static_assert(val * val == uint128_t(0xfdb8e2bacbfe7cefULL, 0x010e6cd7a44a4100ULL));
+
+    constexpr uint128_t lhs(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+    constexpr uint128_t rhs(0xf0f0f0f0f0f0f0f0ULL, 0x0f0f0f0f0f0f0f0fULL);
+    constexpr uint128_t product = lhs * rhs;
+    EXPECT_EQ(lhs * rhs, product);
+    EXPECT_EQ(rhs * lhs, product);
+}
+
+TEST(Arithmetic, multiply_wraps){
+    const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+
+    EXPECT_EQ(max * max, 1);
+    EXPECT_EQ(max * uint128_t(2), uint128_t(0xffffffffffffffffULL, 0xfffffffffffffffeULL));
+    EXPECT_EQ(uint128_t(1, 0) * uint128_t(1, 0), 0);
+    EXPECT_EQ(uint128_t(0xffffffffffffffffULL) * uint128_t(0xffffffffffffffffULL), uint128_t(0xfffffffffffffffeULL, 0x0000000000000001ULL));
+}
+
+TEST(Arithmetic, mul_wide){
+    const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+
+    // (2^128 - 1)^2 = 2^256 - 2^129 + 1
+    EXPECT_EQ(mul_wide(max, max), (uint128_wide_t{ max - 1, 1 }));
+    EXPECT_EQ(mul_wide(max, 0), (uint128_wide_t{ 0, 0 }));
+    EXPECT_EQ(mul_wide(uint128_t(1, 0), uint128_t(1, 0)), (uint128_wide_t{ 1, 0 }));
+    EXPECT_EQ(mul_wide(uint128_t(0xfedbca9876543210ULL), uint128_t(0xfedbca9876543210ULL)),
+              (uint128_wide_t{ 0, uint128_t(0xfdb8e2bacbfe7cefULL, 0x010e6cd7a44a4100ULL) }));
+
+    const uint128_t lhs(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+    const uint128_t rhs(0xf0f0f0f0f0f0f0f0ULL, 0x0f0f0f0f0f0f0f0fULL);
+    EXPECT_EQ(mul_wide(lhs, rhs), (uint128_wide_t{ uint128_t(0x0112233445566778ULL, 0x7665544332210fffULL), lhs * rhs }));
+    EXPECT_EQ(mul_wide(rhs, lhs), mul_wide(lhs, rhs));
+
+    EXPECT_EQ(mulhi(max, max), max - 1);
+    EXPECT_EQ(mulhi(lhs, rhs), uint128_t(0x0112233445566778ULL, 0x7665544332210fffULL));
+    EXPECT_EQ(mulhi(max, 2), 1);
+    EXPECT_EQ(mulhi(uint128_t(1ULL << 63, 0), 2), 1);
+}
+
+TEST(Arithmetic, mul_add_wide){
+    const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+
+    // largest result: (2^128 - 1)^2 + 2^128 - 1 = 2^256 - 2^128
+    EXPECT_EQ(mul_add_wide(max, max, max), (uint128_wide_t{ max, 0 }));
+    EXPECT_EQ(mul_add_wide(0, 0, max), (uint128_wide_t{ 0, max }));
+    EXPECT_EQ(mul_add_wide(max, 1, 1), (uint128_wide_t{ 1, 0 }));
+    EXPECT_EQ(mul_add_wide(uint128_t(0xffffffffffffffffULL), uint128_t(0xffffffffffffffffULL), uint128_t(0xffffffffffffffffULL)),
+              (uint128_wide_t{ 0, uint128_t(0xffffffffffffffffULL, 0) }));
+
+    // carries out of every word
+    const uint128_t lhs(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+    const uint128_t rhs(0xf0f0f0f0f0f0f0f0ULL, 0x0f0f0f0f0f0f0f0fULL);
+    const auto product = mul_wide(lhs, rhs);
+    const auto sum = mul_add_wide(lhs, rhs, max);
+    EXPECT_EQ(sum.lo, product.lo + max);
+    EXPECT_EQ(sum.hi, product.hi + (product.lo + max < product.lo));
+}
+
+TEST(Arithmetic, mul_wide_constexpr){
+    constexpr uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+    static_assert(mul_wide(max, max) == uint128_wide_t{ max - 1, 1 });
+    static_assert(mulhi(uint128_t(1, 0), uint128_t(1, 0)) == 1);
+    static_assert(mul_add_wide(max, max, max) == uint128_wide_t{ max, 0 });
+}
+
+TEST(Arithmetic, multiply_by_integral){
+    const uint128_t val(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+
+    EXPECT_EQ(val * 0xffffffffffffffffULL, val * uint128_t(0xffffffffffffffffULL));
+    EXPECT_EQ(val * 3u, val * uint128_t(3));
+    EXPECT_EQ(val * uint8_t{ 0 }, 0);
+    EXPECT_EQ(val * true, val);
+    EXPECT_EQ(7 * val, val * uint128_t(7));
+
+    // negative factors sign-extend to 128 bits
+    EXPECT_EQ(val * -1, uint128_t(0) - val);
+    EXPECT_EQ(val * -3LL, val * uint128_t(-3LL));
+
+    uint128_t acc = val;
+    acc *= 10u;
+    EXPECT_EQ(acc, val * uint128_t(10));
+
+    static_assert(uint128_t(0xffffffffffffffffULL, 0xffffffffffffffffULL) * 2u == uint128_t(0xffffffffffffffffULL, 0xfffffffffffffffeULL));
+    static_assert(uint128_t(1, 1) * 0x100000000ULL == uint128_t(0x100000000ULL, 0x100000000ULL));
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "uint128.h"
+
+namespace {
+
+const uint128_t max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+
+}
+
+TEST(Overflow, add){
+    uint128_t result;
+    EXPECT_FALSE(add_overflow(uint128_t(1, 2), uint128_t(3, 4), result));
+    EXPECT_EQ(result, uint128_t(4, 6));
+
+    // carry from the lower word only
+    EXPECT_FALSE(add_overflow(uint128_t(0xffffffffffffffffULL), 1, result));
+    EXPECT_EQ(result, uint128_t(1, 0));
+    EXPECT_FALSE(add_overflow(uint128_t(0xfffffffffffffffeULL, 0xffffffffffffffffULL), 1, result));
+    EXPECT_EQ(result, uint128_t(0xffffffffffffffffULL, 0));
+
+    EXPECT_TRUE(add_overflow(max, 1, result));
+    EXPECT_EQ(result, 0);
+    EXPECT_TRUE(add_overflow(max, max, result));
+    EXPECT_EQ(result, max - 1);
+    EXPECT_TRUE(add_overflow(uint128_t(0x8000000000000000ULL, 0), uint128_t(0x8000000000000000ULL, 0), result));
+    EXPECT_EQ(result, 0);
+    // the carry out of the lower word is what overflows
+    EXPECT_TRUE(add_overflow(uint128_t(0xffffffffffffffffULL, 1), uint128_t(0, 0xffffffffffffffffULL), result));
+    EXPECT_EQ(result, 0);
+
+    EXPECT_EQ(add_sat(max, 1), max);
+    EXPECT_EQ(add_sat(max - 1, 1), max);
+    EXPECT_EQ(add_sat(uint128_t(1, 0), 5), uint128_t(1, 5));
+}
+
+TEST(Overflow, sub){
+    uint128_t result;
+    EXPECT_FALSE(sub_overflow(uint128_t(3, 4), uint128_t(1, 2), result));
+    EXPECT_EQ(result, uint128_t(2, 2));
+    EXPECT_FALSE(sub_overflow(uint128_t(1, 0), 1, result));
+    EXPECT_EQ(result, uint128_t(0xffffffffffffffffULL));
+    EXPECT_FALSE(sub_overflow(max, max, result));
+    EXPECT_EQ(result, 0);
+
+    EXPECT_TRUE(sub_overflow(0, 1, result));
+    EXPECT_EQ(result, max);
+    // the borrow out of the lower word is what overflows
+    EXPECT_TRUE(sub_overflow(uint128_t(1, 0), uint128_t(1, 1), result));
+    EXPECT_EQ(result, max);
+    EXPECT_TRUE(sub_overflow(uint128_t(1, 5), uint128_t(2, 5), result));
+    EXPECT_EQ(result, uint128_t(0xffffffffffffffffULL, 0));
+
+    EXPECT_EQ(sub_sat(0, 1), 0);
+    EXPECT_EQ(sub_sat(uint128_t(1, 0), uint128_t(1, 1)), 0);
+    EXPECT_EQ(sub_sat(uint128_t(1, 0), 1), uint128_t(0xffffffffffffffffULL));
+}
+
+TEST(Overflow, mul){
+    uint128_t result;
+    EXPECT_FALSE(mul_overflow(uint128_t(0xffffffffffffffffULL), uint128_t(0xffffffffffffffffULL), result));
+    EXPECT_EQ(result, uint128_t(0xfffffffffffffffeULL, 1));
+    EXPECT_FALSE(mul_overflow(uint128_t(1, 0), uint128_t(0xffffffffffffffffULL), result));
+    EXPECT_EQ(result, uint128_t(0xffffffffffffffffULL, 0));
+    EXPECT_FALSE(mul_overflow(max, 1, result));
+    EXPECT_EQ(result, max);
+    EXPECT_FALSE(mul_overflow(0, max, result));
+    EXPECT_EQ(result, 0);
+
+    // both upper words set
+    EXPECT_TRUE(mul_overflow(uint128_t(1, 0), uint128_t(1, 0), result));
+    EXPECT_EQ(result, 0);
+    // cross product does not fit in 64 bits
+    EXPECT_TRUE(mul_overflow(uint128_t(2, 0), uint128_t(0x8000000000000000ULL), result));
+    EXPECT_EQ(result, 0);
+    // cross product fits, adding the high half of the low product carries out
+    EXPECT_TRUE(mul_overflow(uint128_t(0xffffffffffffffffULL), uint128_t(0xffffffffffffffffULL, 0xffffffffffffffffULL), result));
+    EXPECT_EQ(result, uint128_t(0xffffffffffffffffULL, 0) * 0xffffffffffffffffULL + uint128_t(0xfffffffffffffffeULL, 1));
+    EXPECT_TRUE(mul_overflow(max, 2, result));
+    EXPECT_EQ(result, max - 1);
+    EXPECT_FALSE(mul_overflow(uint128_t(0x7fffffffffffffffULL, 0xffffffffffffffffULL), 2, result));
+    EXPECT_EQ(result, max - 1);
+
+    EXPECT_EQ(mul_sat(max, 2), max);
+    EXPECT_EQ(mul_sat(uint128_t(1, 0), uint128_t(1, 0)), max);
+    EXPECT_EQ(mul_sat(uint128_t(1, 0), 3), uint128_t(3, 0));
+}
+
+TEST(Overflow, mul_matches_mul_wide){
+    // the flag is set exactly when the high half of the full product is not zero
+    const uint128_t values[] = {
+        0, 1, 2, 3, uint128_t(0xffffffffffffffffULL), uint128_t(1, 0), uint128_t(1, 1), uint128_t(0x100000000ULL),
+        uint128_t(0xffffffffULL, 0xffffffffffffffffULL), uint128_t(0x1ffffffffULL), max, max - 1, uint128_t(0x8000000000000000ULL, 0),
+    };
+    for (auto const lhs : values) {
+        for (auto const rhs : values) {
+            uint128_t result;
+            auto const overflow = mul_overflow(lhs, rhs, result);
+            auto const wide = mul_wide(lhs, rhs);
+            EXPECT_EQ(overflow, wide.hi != 0) << lhs << " * " << rhs;
+            EXPECT_EQ(result, wide.lo) << lhs << " * " << rhs;
+        }
+    }
+}
+
+TEST(Overflow, constexpr){
+    constexpr uint128_t constexpr_max(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+    static_assert(add_sat(constexpr_max, 1) == constexpr_max);
+    static_assert(sub_sat(1, 2) == 0);
+    static_assert(mul_sat(uint128_t(1, 0), uint128_t(1, 0)) == constexpr_max);
+    static_assert(mul_sat(uint128_t(1, 0), 2) == uint128_t(2, 0));
+    static_assert([] {
+        uint128_t result;
+        return add_overflow(constexpr_max, 2, result) && result == 1;
+    }());
+}